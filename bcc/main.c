@@ -18,6 +18,10 @@
 #include <string.h>
 //#include <sys/times.h>
 #include <time.h>
+#include <stdlib.h>
+#include <pthread.h>
+#include <dirent.h>
+#include <sys/stat.h>
 
 /*============================================================*/
 
@@ -270,10 +274,271 @@ int bc_ExecuteParse(const char *s)
   return 1;
 }
 
+/*============================================================*/
+/*
+  batch execution: many independent JSON jobs, executed by a pool of worker threads
+
+  Each job is one JSON input file. bc_ExecuteVector() creates its own bcp object, so
+  jobs do not share any problem state and can run in parallel.
+  The result of "input.json" is written to "input.out.json".
+*/
+
+struct bc_batch_struct
+{
+  char **name_list;             // input files
+  double *latency_list;         // wall clock time in seconds for each job
+  int *result_list;             // 1 if the job was executed successfully
+  int cnt;
+  int max;
+  int next;                     // next job to execute, protected by mutex
+  int isCompact;
+  pthread_mutex_t mutex;
+};
+typedef struct bc_batch_struct bc_batch_t;
+
+static double bc_get_wall_clock(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec + (double)ts.tv_nsec/1000000000.0;
+}
+
+static int bc_batch_is_json_name(const char *name)
+{
+  size_t len = strlen(name);
+  if ( len < 5 || strcmp(name+len-5, ".json") != 0 )
+    return 0;
+  if ( len >= 9 && strcmp(name+len-9, ".out.json") == 0 )
+    return 0;           // ignore the output of a previous batch run
+  return 1;
+}
+
+static int bc_batch_add(bc_batch_t *b, const char *dir, const char *name)
+{
+  char *s;
+  if ( b->cnt >= b->max )
+  {
+    char **n = (char **)realloc(b->name_list, sizeof(char *)*(b->max+64));
+    if ( n == NULL )
+      return 0;
+    b->name_list = n;
+    b->max += 64;
+  }
+  s = (char *)malloc((dir==NULL?0:strlen(dir)+1) + strlen(name) + 1);
+  if ( s == NULL )
+    return 0;
+  s[0] = '\0';
+  if ( dir != NULL )
+  {
+    strcpy(s, dir);
+    strcat(s, "/");
+  }
+  strcat(s, name);
+  b->name_list[b->cnt++] = s;
+  return 1;
+}
+
+static int bc_batch_cmp_name(const void *a, const void *b)
+{
+  return strcmp(*(char * const *)a, *(char * const *)b);
+}
+
+/*
+  batch_arg is either a directory (all *.json files are used) or a text file with one JSON filename per line
+*/
+static int bc_batch_read_job_list(bc_batch_t *b, const char *batch_arg)
+{
+  struct stat st;
+  if ( stat(batch_arg, &st) != 0 )
+    return perror(batch_arg), 0;
+  if ( S_ISDIR(st.st_mode) )
+  {
+    struct dirent *de;
+    DIR *d = opendir(batch_arg);
+    if ( d == NULL )
+      return perror(batch_arg), 0;
+    while( (de = readdir(d)) != NULL )
+      if ( bc_batch_is_json_name(de->d_name) )
+        if ( bc_batch_add(b, batch_arg, de->d_name) == 0 )
+          return closedir(d), 0;
+    closedir(d);
+    if ( b->cnt > 1 )
+      qsort(b->name_list, b->cnt, sizeof(char *), bc_batch_cmp_name);
+  }
+  else
+  {
+    char buf[4096];
+    FILE *fp = fopen(batch_arg, "r");
+    if ( fp == NULL )
+      return perror(batch_arg), 0;
+    while( fgets(buf, sizeof(buf), fp) != NULL )
+    {
+      size_t len = strlen(buf);
+      while( len > 0 && (unsigned char)buf[len-1] <= ' ' )
+        buf[--len] = '\0';
+      if ( len == 0 || buf[0] == '#' )
+        continue;
+      if ( bc_batch_add(b, NULL, buf) == 0 )
+        return fclose(fp), 0;
+    }
+    fclose(fp);
+  }
+  return 1;
+}
+
+static int bc_batch_execute_job(const char *in_name, int isCompact)
+{
+  char *out_name;
+  size_t len = strlen(in_name);
+  FILE *in_fp;
+  FILE *out_fp;
+  co in;
+  co out;
+  
+  out_name = (char *)malloc(len + 10);
+  if ( out_name == NULL )
+    return 0;
+  strcpy(out_name, in_name);
+  if ( len >= 5 && strcmp(out_name+len-5, ".json") == 0 )
+    out_name[len-5] = '\0';
+  strcat(out_name, ".out.json");
+  
+  in_fp = fopen(in_name, "r");
+  if ( in_fp == NULL )
+    return perror(in_name), free(out_name), 0;
+  in = coReadJSONByFP(in_fp);
+  fclose(in_fp);
+  if ( in == NULL || coIsVector(in) == 0 )
+  {
+    fprintf(stderr, "%s: JSON read error\n", in_name);
+    if ( in != NULL )
+      coDelete(in);
+    return free(out_name), 0;
+  }
+  out = bc_ExecuteVector(in);
+  out_fp = fopen(out_name, "w");
+  if ( out_fp == NULL )
+    return perror(out_name), coDelete(out), coDelete(in), free(out_name), 0;
+  coWriteJSON(out, isCompact, 1, out_fp);
+  fclose(out_fp);
+  coDelete(out);
+  coDelete(in);
+  free(out_name);
+  return 1;
+}
+
+static void *bc_batch_worker(void *arg)
+{
+  bc_batch_t *b = (bc_batch_t *)arg;
+  int job;
+  double start;
+  for(;;)
+  {
+    pthread_mutex_lock(&(b->mutex));
+    job = b->next;
+    if ( job < b->cnt )
+      b->next++;
+    pthread_mutex_unlock(&(b->mutex));
+    if ( job >= b->cnt )
+      break;
+    start = bc_get_wall_clock();
+    b->result_list[job] = bc_batch_execute_job(b->name_list[job], b->isCompact);
+    b->latency_list[job] = bc_get_wall_clock() - start;
+    logprint(1, "batch job %d/%d '%s' time=%.3lf", job+1, b->cnt, b->name_list[job], b->latency_list[job]);
+  }
+  return NULL;
+}
+
+static int bc_batch_cmp_dbl(const void *a, const void *b)
+{
+  double x = *(const double *)a;
+  double y = *(const double *)b;
+  return x < y ? -1 : (x > y ? 1 : 0);
+}
+
+/* nearest rank percentile from a sorted list */
+static double bc_batch_percentile(const double *sorted, int cnt, int percent)
+{
+  int pos = (cnt*percent + 99)/100 - 1;
+  if ( pos < 0 )
+    pos = 0;
+  return sorted[pos];
+}
+
+/* free the job names and the result lists of "b" */
+static void bc_batch_clear(bc_batch_t *b)
+{
+  int i;
+  for( i = 0; i < b->cnt; i++ )
+    free(b->name_list[i]);
+  free(b->name_list);
+  free(b->latency_list);
+  free(b->result_list);
+  memset(b, 0, sizeof(bc_batch_t));
+}
+
+int bc_ExecuteJSONBatch(const char *batch_arg, int thread_cnt, int isCompact)
+{
+  bc_batch_t b;
+  pthread_t *thread_list;
+  int i;
+  int ok_cnt = 0;
+  int is_ok;
+  double start, total;
+  
+  memset(&b, 0, sizeof(b));
+  b.isCompact = isCompact;
+  if ( bc_batch_read_job_list(&b, batch_arg) == 0 )
+    return bc_batch_clear(&b), 0;
+  if ( b.cnt == 0 )
+    return printf("batch: no JSON jobs found in '%s'\n", batch_arg), bc_batch_clear(&b), 0;
+  if ( thread_cnt < 1 )
+    thread_cnt = 1;
+  if ( thread_cnt > b.cnt )
+    thread_cnt = b.cnt;
+    
+  b.latency_list = (double *)malloc(sizeof(double)*b.cnt);
+  b.result_list = (int *)malloc(sizeof(int)*b.cnt);
+  thread_list = (pthread_t *)malloc(sizeof(pthread_t)*thread_cnt);
+  if ( b.latency_list == NULL || b.result_list == NULL || thread_list == NULL )
+    return puts("batch: memory error"), free(thread_list), bc_batch_clear(&b), 0;
+  pthread_mutex_init(&(b.mutex), NULL);
+  
+  start = bc_get_wall_clock();
+  for( i = 0; i < thread_cnt; i++ )
+    if ( pthread_create(thread_list+i, NULL, bc_batch_worker, &b) != 0 )
+      break;
+  thread_cnt = i;
+  if ( thread_cnt == 0 )
+    bc_batch_worker(&b);               // no thread could be created, do the work here
+  for( i = 0; i < thread_cnt; i++ )
+    pthread_join(thread_list[i], NULL);
+  total = bc_get_wall_clock() - start;
+  pthread_mutex_destroy(&(b.mutex));
+  
+  for( i = 0; i < b.cnt; i++ )
+    if ( b.result_list[i] )
+      ok_cnt++;
+  qsort(b.latency_list, b.cnt, sizeof(double), bc_batch_cmp_dbl);
+  
+  printf("batch: jobs=%d failed=%d threads=%d wall time=%.3lfs throughput=%.2lf jobs/s\n", 
+    b.cnt, b.cnt-ok_cnt, thread_cnt==0?1:thread_cnt, total, total > 0.0 ? b.cnt/total : 0.0);
+  printf("batch: latency p50=%.3lfs p90=%.3lfs p99=%.3lfs max=%.3lfs\n", 
+    bc_batch_percentile(b.latency_list, b.cnt, 50),
+    bc_batch_percentile(b.latency_list, b.cnt, 90),
+    bc_batch_percentile(b.latency_list, b.cnt, 99),
+    b.latency_list[b.cnt-1]);
+  
+  free(thread_list);
+  is_ok = ok_cnt == b.cnt;
+  bc_batch_clear(&b);
+  return is_ok;
+}
+
 
 const char *json_input_spec = 
 "JSON Input    := [ <block> ]\n"
-"block         := <bcl2slot>|<show>|<minimize>|<complement>|<group2zero0>|<intersection0>|<subtract0>|<equal0>|<exchange0>|<copy0to>|<copy0from>|<setup>\n"
+"block         := <bcl2slot>|<show>|<minimize>|<complement>|<group2zero0>|<intersection0>|<intersection0empty>|<subtract0>|<equal0>|<exchange0>|<copy0to>|<copy0from>|<setup>\n"
 "bcl2slot      := { \"cmd\":\"bcl2slot\", <bx>, \"slot\":<slnr> } Copy the given input <bx> into a slot with number <slnr>\n"
 "show          := { \"cmd\":\"show\", <bxs>  }                  Show the content of <bxs>\n"
 "minimize      := { \"cmd\":\"minimize\", \"slot\":<slnr>  }      Minimize the content of the specified slot\n"
@@ -286,6 +551,7 @@ const char *json_input_spec =
 "xgroup        := { \"cmd\":\"xgroup\", <bx>}                   Register the first minterm as a group of variables, which exclude each other (expr:a&b&c will register a, b and c)\n"
 "       xgroups are applied to bcl, expr, bcl2slot, complement, intersection0, union0, subtract0\n"
 "intersection0 := { \"cmd\":\"intersection0\", <bxs>, <l> }     Intersection ('AND') of slot 0 and <bxs>, result in slot 0\n"
+"intersection0empty := { \"cmd\":\"intersection0empty\", <bxs>, <l> }  Check whether the intersection of slot 0 and <bxs> is empty, slot 0 is not modified\n"
 "union0        := { \"cmd\":\"union0\", <bxs>, <l> }            Union ('OR') of slot 0 and <bxs>, result in slot 0\n"
 "subtract0     := { \"cmd\":\"subtract0\", <bxs>, <l> }         Subtract <bxs> from slot 0, result in slot 0\n"
 "equal0        := { \"cmd\":\"equal0\", <bxs>, <l>] }           Compare slot 0 with <bxs>, output result under the given label\n"
@@ -294,6 +560,11 @@ const char *json_input_spec =
 "copy0to       := { \"cmd\":\"copy0to\", \"slot\":<slnr>] }       Copy slot 0 to slot <slnr>\n"
 "copy0from     := { \"cmd\":\"copy0from\", <bxs>] }             Copy <bxs> to slot 0\n""setup         := { \"xend\":\";\", \"xand\":\"&\", \"xor\":\"|\", \"xnot\":\"-\", \"xtrue\":\"1\", \"xfalse\":\"0\" }  Redefine parser\n"  
 "l             := \"label\":<key> | \"label0\":<key>            Output result flags (and slot 0 content) to the output JSON map\n"
+"lim           := \"timeLimit\":<sec> | \"nodeLimit\":<n> | \"cubeLimit\":<n>  Resource limits for the cmd of the same block (wall clock, recursion steps, cubes per list)\n"
+"sub           := \"subtractOrder\":\"list\"|\"literals\"|\"overlap\"|\"greedy\" | \"subtractStats\":1  Order of the subtracted cubes, output of <substat> for the cmd of the same block\n"
+"spill         := \"spillCubes\":<n> | \"spillDir\":<dir>    Move lists with at least <n> cubes into a temporary file in <dir> (default $TMPDIR or /tmp) for the cmd of the same block\n"
+"mode          := \"mode\":\"default\"|\"espresso\"|\"exact\"  Minimization algorithm for the cmd of the same block, \"espresso\" repeats reduce, expand and irredundant, output of <espstat>,\n"
+"                 \"exact\" calculates a minimum cover (up to 20 variables) within the <lim> limits, otherwise espresso is used, output of <exact>\n"
 "iv            := \"ignoreVars\":<?>                          If present, then the variables of any \"expr\" of the current cmd block are ignored, useful for variable groups\n"   
 "key           := Any ASCII String                          Use this <key> as a key of the generated output JSON map\n" 
 "bx            := \"bcl\":<bclsv> | \"expr\":<exprstr> | \"mtvar\":<mtstr> | <iv>\n"
@@ -309,15 +580,19 @@ const char *json_input_spec =
 const char *json_output_spec = 
 "JSON Output := { \"key\":<rblk> }         The keys are taken from label/label0 values of the input JSON\n"
 "rblk        := { <result> }\n"
-"result      := <index> | <empty> | <subset> | <superset> | <bcl> | <expr>\n"
+"result      := <index> | <empty> | <subset> | <superset> | <bcl> | <expr> | <budget> | <substat> | <espstat> | <exact>\n"
 "index       := \"index\":<integer>        The position of corresponding block in the JSON input\n"
 "empty       := \"empty\":<integer>        1 if slot 0 is empty\n"
 "subset      := \"subset\":<integer>       1 if slot 0 is subset of/equal with <bxs> for <equal0> cmd\n"
 "superset    := \"superset\":<integer>     1 if slot 0 is superset of/equal <bxs> for <equal0> cmd\n"
 "bcl         := \"bcl\":<bclvec>           Content of slot 0 as a binary cube list\n"
 "expr        := \"expr\":<expr>            Content of slot 0 as a binary expression\n"
+"budget      := \"budgetExceeded\":1      The cmd was stopped by one of the <lim> limits, the result in slot 0 is incomplete\n"
+"substat     := \"subtractStats\":{ \"steps\":<n>, \"peak\":<n>, \"time\":<sec>, \"stepSize\":[<n>], \"stepTime\":[<sec>] }  Last subtract of the cmd, if requested with <sub>\n"
+"espstat     := \"espressoStats\":[ { \"cubes\":<n>, \"literals\":<n> } ]  Cost after each iteration of the last minimize of the cmd, if requested with <mode>, missing for cached results\n"
+"exact       := \"exact\":<integer>        1 if the result of the last minimize of the cmd has the minimum number of cubes, if requested with <mode>\n"
 "The JSON output contains a special <rblk> with the variable definition:\n"
-"\"\":{ \"vmap\":<map with variables>, \"vlist\":<vector with variables> }\n"
+"\"\":{ \"vmap\":<map with variables>, \"vlist\":<vector with variables>, \"tautCacheHit\":<n>, \"tautCacheMiss\":<n>, \"coverCexHit\":<n>, \"resultCacheHit\":<n>, \"resultCacheMiss\":<n> }\n"
 ;
 
 
@@ -334,6 +609,9 @@ void help()
   puts("-ojpp                           Pretty print JSON output.");
   puts("-ojson <json file>              Provide filename for the JSON output.");
   puts("-json <json file>               Parse and execute commands from JSON input file (this option can be used multiple times).");
+  puts("-j <n>                          Number of worker threads for the next '-batch' option (default 1).");
+  puts("-batch <dir|list file>          Execute each JSON file of the directory (or listed in the file) as an independent job.");
+  puts("                                The result of 'name.json' is written to 'name.out.json'.");
   printf("%s", json_input_spec);
   printf("%s", json_output_spec);
 }
@@ -343,6 +621,7 @@ int isCompactJSONOutput = 1;
 #define JSON_INPUT_FILE_MAX 64
 const char *json_input_filenames[JSON_INPUT_FILE_MAX];
 int json_input_file_cnt = 0;
+int batch_thread_cnt = 1;
 
 int main(int argc, char **argv)
 {
@@ -418,6 +697,23 @@ int main(int argc, char **argv)
       //printf("\nuser time: %lld\n", (long long int)(end.tms_utime-start.tms_utime));
       argv++;
     }
+    else if ( strcmp(*argv, "-j") == 0 )
+    {
+      argv++;
+      if ( (*argv) == NULL )
+        return puts("number of threads missing"), 1;
+      batch_thread_cnt = atoi(*argv);
+      argv++;
+    }
+    else if ( strcmp(*argv, "-batch") == 0 )
+    {
+      argv++;
+      if ( (*argv) == NULL )
+        return puts("batch directory or list file missing"), 1;
+      if ( bc_ExecuteJSONBatch(*argv, batch_thread_cnt, isCompactJSONOutput) == 0 )
+        return puts("batch execution failed"), 1;
+      argv++;
+    }
     else if ( strcmp(*argv, "-dimacscnf") == 0 )
     {
       argv++;
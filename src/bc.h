@@ -59,10 +59,50 @@ typedef struct bcp_struct *bcp;		// problem structure, required as first argumen
 typedef __m128i *bc;		// a single boolean cube is a vector of __m128i objects. The size of this vector is stored in the "blk_cnt" member of bcp
 typedef struct bcl_struct *bcl;		// boolean cube list
 typedef struct bcx_struct *bcx;		// abstract syntax tree of a boolean cube expresion
+typedef struct bci_struct *bci;		// inverted literal index of a boolean cube list
 
 
 /* boolean cube problem, each function will require a pointer to this struct */
 #define BCP_MAX_STACK_FRAME_DEPTH 500
+#define BCP_TAUT_TT_MAX_VAR_CNT 16              // upper limit for the truth table evaluation in the tautology test (table with 2^16 bits)
+#define BCP_SCC_INDEX_MIN_CNT 1000             // use the inverted literal index in the single cube containment for lists with at least this number of cubes
+#define BCP_SUBTRACT_INDEX_MIN_CNT 20000L     // use the inverted literal index in the subtract containment, if the number of new cubes times the size of the list is at least this value
+#define BCP_INTERSECTION_JOIN_MIN_CNT 4096L   // use the bucket join in the intersection for at least this number of cube pairs, see bclintersection.c
+#define BCP_INTERSECTION_JOIN_VAR_CNT 4       // max number of bucket variables in the intersection (3^4 buckets)
+
+/* resource governor, see bcgovernor.c */
+struct bcp_governor_struct
+{
+  clock_t time_limit;   // max wall clock time in CLOCKS_PER_SEC units, 0: no limit
+  long node_limit;      // max number of recursion nodes and loop steps, 0: no limit
+  int cube_limit;       // max number of cubes in a single list, 0: no limit
+  clock_t start;        // monotonic clock of the last bcp_StartGovernor()
+  long node_cnt;        // nodes since the last bcp_StartGovernor()
+  int is_active;        // at least one limit is set
+  int is_exceeded;      // one of the limits has been reached
+};
+
+/* statistics of the last bcp_SubtractBCL() call, see bclsubtract.c */
+struct bcp_subtract_stat_struct
+{
+  int step_cnt;         // number of processed cubes of the subtrahend
+  int peak_cnt;         // max number of cubes after a step
+  clock_t total_clock;  // monotonic clock for the complete subtract
+  int is_record;        // if set, then the size and the duration of each step are stored in the lists below
+  int *size_list;       // number of cubes after each step
+  clock_t *clock_list;  // monotonic clock for each step
+  int list_max;         // allocated entries of size_list and clock_list
+};
+
+/* cost of each iteration of the last bcp_MinimizeBCLWithEspresso() call, see bclespresso.c */
+struct bcp_espresso_stat_struct
+{
+  int iteration_cnt;    // number of entries in the lists below, -1 if the result was taken from the result cache
+  int *cube_cnt_list;   // number of cubes after each iteration
+  int *literal_cnt_list;        // number of literals after each iteration
+  int list_max;         // allocated entries of cube_cnt_list and literal_cnt_list
+};
+
 struct bcp_struct
 {
   int var_cnt;  // number of variables per cube
@@ -86,12 +126,87 @@ struct bcp_struct
   int x_var_cnt;         // variable counter for expressions, should be equal to coMapSize(var_map)
   
 	
-  clock_t clock_do_bcl_multi_cube_containment;		// max time limit given for multi cube containment operation, must be seconds*CLOCKS_PER_SEC
+  clock_t clock_do_bcl_multi_cube_containment;		// max time limit (wall clock) given for multi cube containment operation, must be seconds*CLOCKS_PER_SEC
+  struct bcp_governor_struct gov;
+  int subtract_order;           // order of the subtrahend cubes in bcp_SubtractBCL(), BCP_SUBTRACT_ORDER_xxx
+  struct bcp_subtract_stat_struct subtract_stat;
+  int minimize_mode;            // algorithm of bcp_MinimizeBCL(), BCP_MINIMIZE_MODE_xxx
+  struct bcp_espresso_stat_struct espresso_stat;
+  int is_minimize_exact;        // 1 if the last bcp_MinimizeBCL() result is minimal, see bclexact.c
+
+  /* tautology memo cache, see bcltautology.c */
+  struct bcp_taut_cache_struct *taut_cache;     // allocated with the first tautology test, NULL if not allocated
+  int taut_cache_size;          // number of entries in the cache (will be rounded up to a power of two), 0 disables the cache
+  int taut_cache_alloc_size;    // number of allocated entries in taut_cache
+  unsigned taut_cache_hand;     // clock hand for the replacement of entries
+  int taut_cache_min_cnt;       // only lists with at least this number of cubes are stored in the cache
+  long taut_cache_hit_cnt;
+  long taut_cache_miss_cnt;
+  __m128i *taut_cache_minterm_list;     // one minterm (p->blk_cnt blocks) for each entry of taut_cache, allocated with the first minterm
+  
+  int taut_tt_max_var_cnt;      // max number of variables for the truth table evaluation in the tautology test, 0 disables the truth table
+  
+  /* row array for the in-place tautology test, see bcltautology.c */
+  bc *taut_row_list;
+  int taut_row_cnt;             // used entries
+  int taut_row_max;             // allocated entries
+  int *taut_part_list;          // work area for the partition of the rows into independent components
+  int taut_part_max;            // allocated entries
+  uint32_t *taut_var_cnt_list;  // stack of column statistics (bcp_GetVarCntListSize() entries per slot) for the rows
+  int taut_var_cnt_cnt;         // used slots
+  int taut_var_cnt_max;         // allocated slots
+  bc taut_minterm;              // if not NULL, the recursion stores a minterm, which is not covered by the rows
+  
+  /* counterexample cache for the cover test, see bclcontainment.c */
+  bcl cover_cex_list;           // minterms, which were not covered in previous tests, allocated with the first cover test
+  int cover_cex_size;           // max number of minterms in cover_cex_list, 0 disables the cache
+  int cover_cex_pos;            // position for the next minterm, if the list is full
+  long cover_cex_hit_cnt;       // number of cover tests answered by the counterexample cache
+  
+  /* result cache for complement, minimize, xgroup and subset, see bclcache.c */
+  struct bcp_result_cache_struct *result_cache; // allocated with the first store, NULL if not allocated
+  int result_cache_size;        // number of entries in the cache, 0 disables the cache
+  int result_cache_alloc_size;  // number of allocated entries in result_cache
+  int result_cache_pos;         // position for the next entry, if the cache is full
+  int result_cache_min_cnt;     // only lists with at least this number of cubes are stored in the cache
+  long result_cache_hit_cnt;
+  long result_cache_miss_cnt;
+  
+  /* out of core storage for large lists, see bclspill.c */
+  int spill_cnt;                // lists with at least this number of cubes are moved to a temporary file, 0 disables the spill mode
+  char *spill_dir;              // directory for the temporary files, NULL: use $TMPDIR or /tmp, not owned by bcp
+  long spill_list_cnt;          // number of lists, which have been moved to a temporary file
 	
   co var_map;           // map with all variables, key=name, value=position (double), p->x_var_cnt contains the number of variables in var_map
   co var_list;                  // vector with all variables, derived from var_map, use coPrint(p->var_list); puts(""); to print the variables
 };
 
+/* one entry of the tautology memo cache */
+struct bcp_taut_cache_struct
+{
+  uint64_t fp1;         // fingerprint of the cube list, independent from the order of the cubes
+  uint64_t fp2;
+  int cnt;              // number of cubes in the list
+  uint8_t is_used;
+  uint8_t is_ref;       // reference bit for the clock replacement
+  uint8_t is_tautology;
+  uint8_t is_minterm;   // p->taut_cache_minterm_list contains a not covered minterm for this entry
+};
+
+/* key and value of the result cache, see bclcache.c */
+struct bcp_result_cache_struct
+{
+  int op;               // BCP_RESULT_CACHE_xxx, 0 for an unused entry
+  uint64_t fp1;         // fingerprint of the first argument
+  uint64_t fp2;
+  int cnt;              // number of cubes in the first argument
+  uint64_t arg_fp1;     // fingerprint of the second argument (second list or xgroup list), 0 if not used
+  uint64_t arg_fp2;
+  int arg_cnt;
+  bcl result;           // result list, shared with the callers, must not be modified
+  int value;            // result value, if result is NULL
+};
+
 /* a list of boolean cubes */
 struct bcl_struct
 {
@@ -100,6 +215,24 @@ struct bcl_struct
   int last_deleted;
   __m128i *list;        // max * var_cnt / 64 entries
   uint8_t *flags;       // bit 0 is the cube deleted flag
+  uint32_t *var_cnt_list;       // number of zeros and ones for each variable, see bccofactor.c, NULL if not allocated
+  int is_var_cnt_valid;         // 0 if the list has been modified after the calculation of var_cnt_list
+  int spill_fd;                 // file descriptor of the temporary file for "list", -1 if "list" is on the heap, see bclspill.c
+};
+
+/* inverted literal index of a boolean cube list, see bclindex.c */
+struct bci_struct
+{
+  int post_cnt;                 // number of posting lists: two for each variable and one for cubes without literal or with illegal variable
+  int **post_list;              // cube positions for each literal: 2*var_pos for zero, 2*var_pos+1 for one
+  int *post_len;                // used entries of each posting list
+  int *post_max;                // allocated entries of each posting list
+  int cube_max;                 // allocated entries of the following lists
+  int *lit_cnt_list;            // number of literals of each cube
+  uint64_t *sig_list;           // literal signature of each cube, see bcp_GetCubeLiteralSignature()
+  uint32_t *hit_list;           // hit counter for each cube, valid if stamp_list[pos] == stamp
+  uint32_t *stamp_list;
+  uint32_t stamp;               // query number
 };
 
 /* boolean cube expression */
@@ -143,6 +276,18 @@ void bcp_StartCubeStackFrame(bcp p);
 void bcp_EndCubeStackFrame(bcp p);
 bc bcp_GetTempCube(bcp p);	// requires bcp_StartCubeStackFrame()
 
+/* bcgovernor.c */
+
+clock_t bcp_GetMonotonicClock(void);
+void bcp_StartGovernor(bcp p);
+void bcp_SetGovernor(bcp p, double time_limit, long node_limit, int cube_limit);    // 0 disables a limit, time_limit in seconds
+int bcp_SetGovernorExceeded(bcp p, const char *limit_name);      // always returns 0
+int bcp_CountGovernorNode(bcp p);     // count one node, returns 0 if the budget is exceeded, use bcp_CheckGovernor() instead
+/* macro: count one node if the governor is active, returns 0 if the budget is exceeded */
+#define bcp_CheckGovernor(p) ((p)->gov.is_active == 0 ? 1 : bcp_CountGovernorNode(p))
+/* macro: returns 1 if one of the limits has been exceeded */
+#define bcp_IsGovernorExceeded(p) ((p)->gov.is_exceeded)
+
 /* bcube.c */
 /* core functions */
 
@@ -171,12 +316,15 @@ int bcp_IntersectionCube(bcp p, bc r, bc a, bc b); // returns 0, if there is no
 int bcp_IsIntersectionCube(bcp p, bc a, bc b); // returns 0, if there is no intersection
 int bcp_IsIllegal(bcp p, bc c);                                 // check whether "c" contains "00" codes
 int bcp_GetCubeVariableCount(bcp p, bc cube);   // return the number of 01 or 10 codes in "cube"
+uint64_t bcp_GetCubeLiteralSignature(bcp p, bc c);      // folded literals, (sig(a) & ~sig(b)) != 0 means that b is not a subset of a
 int bcp_GetCubeDelta(bcp p, bc a, bc b);                // calculate the delta between a and b
 int bcp_IsSubsetCube(bcp p, bc a, bc b);                // is "b" is a subset of "a"
+uint64_t bcp_GetCubeHash(bcp p, bc c);                  // 64 bit hash value of "c"
 
 /* bclcore.c */
 
 #define bcp_GetBCLCnt(p, l) ((l)->cnt)
+#define bcp_InvalidateBCLVarCnt(p, l) ((l)->is_var_cnt_valid = 0)      // must be called if cubes or flags of the list are modified directly
 
 bcl bcp_NewBCL(bcp p);          // create new empty bcl
 bcl bcp_NewBCLByBCL(bcp p, bcl l);      // create a new bcl as a copy of an existing bcl
@@ -201,6 +349,7 @@ bcl bcp_NewBCLByString(bcp p, const char *s);   // create a bcl from a CR seprat
 
 
 int *bcp_GetBCLVarCntList(bcp p, bcl l);
+double bcp_GetBCLMintermCount(bcp p, bcl l);   // number of minterms, only valid if the cubes do not intersect with each other
 
 void bcp_SetBCLFlipVariables(bcp p, bcl l);
 void bcp_SetBCLAllDCToZero(bcp p, bcl l, bcl extra_mask);
@@ -217,8 +366,14 @@ bcl bcp_NewBCLByDIMACSCNF(bcp p, FILE *fp);   // create a bcl from a DIMACS CNF
 
 /* bccofactor.c */
 
-void bcp_CalcBCLBinateSplitVariableTable(bcp p, bcl l);
-int bcp_GetBCLMaxBinateSplitVariableSimple(bcp p, bcl l);
+#define bcp_GetVarCntListSize(p) ((p)->blk_cnt*64*2)       // number of uint32_t entries of a column statistics table
+#define bcp_GetVarCntZeroPos(p, var) (((var)&~63) | (((var)&7)<<3) | (((var)>>3)&7))
+#define bcp_GetVarCntOnePos(p, var) ((p)->blk_cnt*64 + bcp_GetVarCntZeroPos(p, var))
+void bcp_AddCubeVarCnt(bcp p, bc c, uint32_t *var_cnt_list, int dir);       // add (dir=1) or remove (dir=-1) the literals of "c" to/from the table
+void bcp_CalcRowsVarCnt(bcp p, bc *rows, int cnt, uint32_t *var_cnt_list);     // calculate the table for an array of cube pointers
+int bcp_GetMaxBinateSplitVariableByVarCnt(bcp p, const uint32_t *var_cnt_list);
+int bcp_CalcBCLBinateSplitVariableTable(bcp p, bcl l);         // calculate l->var_cnt_list if required, returns 0 for memory error
+int bcp_GetBCLMaxBinateSplitVariableSimple(bcp p, bcl l);       // reference implementation without table
 int bcp_GetBCLMaxBinateSplitVariable(bcp p, bcl l);
 int bcp_IsBCLVariableDC(bcp p, bcl l, unsigned var_pos);
 int bcp_IsBCLVariableUnate(bcp p, bcl l, unsigned var_pos, unsigned value);
@@ -226,7 +381,8 @@ void bcp_DoBCLOneVariableCofactor(bcp p, bcl l, unsigned var_pos, unsigned value
 bcl bcp_NewBCLCofacterByVariable(bcp p, bcl l, unsigned var_pos, unsigned value);       // create a new list, which is the cofactor from "l"
 void bcp_DoBCLCofactorByCube(bcp p, bcl l, bc c, int exclude);         
 bcl bcp_NewBCLCofactorByCube(bcp p, bcl l, bc c, int exclude);          // don't use this fn, use bcp_IsBCLCubeRedundant() or bcp_IsBCLCubeCovered() instead
-int bcp_IsBCLUnate(bcp p);  // requires call to bcp_CalcBCLBinateSplitVariableTable
+bcl bcp_NewBCLIntersectingCofactorByCube(bcp p, bcl l, bc c, int exclude);    // cofactor from the intersecting cubes only, used by bcp_IsBCLCubeCovered()
+int bcp_IsBCLUnate(bcp p, bcl l);  // uses the table of "l" if it is valid
 
 
 /* bclcontainment.c */
@@ -235,26 +391,73 @@ int bcp_IsBCLCubeSingleCovered(bcp p, bcl l, bc c);
 void bcp_DoBCLSingleCubeContainment(bcp p, bcl l);
 int bcp_IsBCLCubeCovered(bcp p, bcl l, bc c);           // is cube c a subset of l (is cube c covered by l)
 int bcp_IsBCLCubeRedundant(bcp p, bcl l, int pos);      // is the cube at pos in l covered by all other cubes in l
+void bcp_ClearCoverCounterexampleCache(bcp p);
+int bcp_IsBCLCubeRefutedByCache(bcp p, bcl l, bc c);    // returns 1 if a cached minterm is inside c and outside of l
 void bcp_DoBCLMultiCubeContainment(bcp p, bcl l);
 
 
+/* bclirredundant.c */
+
+void bcp_DoBCLIrredundant(bcp p, bcl l);         // remove redundant cubes, the result is irredundant
+int bcp_DoBCLExactIrredundant(bcp p, bcl l);     // minimum number of cubes, returns 0 if the problem is too large or the budget is exceeded
+
+/* bclindex.c */
+
+bci bcp_NewBCI(bcp p, bcl l);           // create index for all cubes of l, which are not deleted
+void bcp_DeleteBCI(bcp p, bci x);
+int bcp_AddBCICube(bcp p, bci x, bcl l, int pos);       // add the cube at pos of l to the index, returns 0 for error
+int bcp_FindBCISupersetCube(bcp p, bci x, bcl l, bc c, int exclude);    // position of a cube which contains c, or -1
+int bcp_DoBCISubsetCubeMark(bcp p, bci x, bcl l, bc c, int exclude);    // mark all cubes which are a subset of c, returns the number of marked cubes
+
 /* bcltautology.c */
 
 int bcp_is_bcl_partition(bcp p, bcl l);
+void bcp_ClearTautologyCache(bcp p);
+int bcp_GetBCLFingerprint(bcp p, bcl l, uint64_t *fp1, uint64_t *fp2);       // order independent fingerprint, returns the number of cubes
+int bcp_IsBCLTautologyWithCopy(bcp p, bcl l);        // old implementation, creates a copy of the list for each cofactor
 int bcp_IsBCLTautology(bcp p, bcl l);
+int bcp_IsBCLTautologyWithMinterm(bcp p, bcl l, bc minterm);  // returns 0 and a not covered minterm if l is not a tautology, -1 for memory error
+
+
+/* bclcache.c */
+
+#define BCP_RESULT_CACHE_COMPLEMENT 1
+#define BCP_RESULT_CACHE_MINIMIZE 2
+#define BCP_RESULT_CACHE_XGROUP 3
+#define BCP_RESULT_CACHE_SUBSET 4
+#define BCP_RESULT_CACHE_ESPRESSO 5
+#define BCP_RESULT_CACHE_EXACT 6
+void bcp_ClearResultCache(bcp p);
+int bcp_GetResultCacheKey(bcp p, struct bcp_result_cache_struct *key, int op, bcl a, bcl b);   // returns 0 if the result should not be cached
+struct bcp_result_cache_struct *bcp_FindResultCache(bcp p, struct bcp_result_cache_struct *key);      // returns NULL if there is no result for the key
+int bcp_AddResultCacheBCL(bcp p, struct bcp_result_cache_struct *key, bcl result);  // stores a copy of the result, returns 0 for memory error
+int bcp_AddResultCacheValue(bcp p, struct bcp_result_cache_struct *key, int value);
+
+/* bclspill.c */
 
+int bcp_ResizeBCLList(bcp p, bcl l, int max);   // resize the cube memory and the flags of "l", returns 0 for memory error
+void bcp_FreeBCLList(bcp p, bcl l);
+int bcp_IsBCLSpilled(bcp p, bcl l);
 
 /* bclsubtract.c */
 
 // void bcp_DoBCLSharpOperation(bcp p, bcl l, bc a, bc b);
+#define BCP_SUBTRACT_MCC 1
+#define BCP_SUBTRACT_DISJOINT 2
+#define BCP_SUBTRACT_ORDER_LIST 0       // order of the cubes in the list
+#define BCP_SUBTRACT_ORDER_LITERALS 1   // most literals first
+#define BCP_SUBTRACT_ORDER_OVERLAP 2    // cubes, which intersect with most of the cubes of the minuend, first
+#define BCP_SUBTRACT_ORDER_GREEDY 3     // in each step the cube with the smallest predicted growth of the result
+int bcp_GetSubtractOrderByName(const char *name);       // returns -1 for unknown names
 int bcp_SubtractBCL(bcp p, bcl a, bcl b, int is_mcc);  // if is_mcc is 0, then the substract operation will generate all prime cubes. returns 0 for error
 
 /* bclcomplement.c */
 
-bcl bcp_NewBCLComplementWithSubtract(bcp p, bcl l);  // faster than with cofactor
-bcl bcp_NewBCLComplementWithCofactor(bcp p, bcl l); // slow!
-bcl bcp_NewBCLComplement(bcp p, bcl l);         // calls bcp_NewBCLComplementWithSubtract();
+bcl bcp_NewBCLComplementWithSubtract(bcp p, bcl l);
+bcl bcp_NewBCLComplementWithCofactor(bcp p, bcl l); // unate recursive complement (Espresso COMPLEMENT)
+bcl bcp_NewBCLComplement(bcp p, bcl l);         // calls bcp_NewBCLComplementWithCofactor();
 bcl bcp_NewBCLComplementWithIntersection(bcp p, bcl l);
+bcl bcp_NewBCLDisjointComplement(bcp p, bcl l);         // complement with disjoint cubes, see bcp_GetBCLMintermCount()
 int bcp_ComplementBCL(bcp p, bcl l);            // in place complement calculation
 
 
@@ -270,11 +473,12 @@ int bcp_IsBCLEqual(bcp p, bcl a, bcl b);                // checks whether the tw
 
 int bcp_IntersectionBCLs(bcp p, bcl result, bcl a, bcl b); // result = a intersection with b
 int bcp_IntersectionBCL(bcp p, bcl a, bcl b);   // a = a intersection with b 
+int bcp_IsBCLIntersectionEmpty(bcp p, bcl a, bcl b);   // 1 if the intersection (with xgroups applied) is empty, -1 for memory error or budget exceeded
 
 /* bclexpand.c */
 
 void bcp_DoBCLSimpleExpand(bcp p, bcl l);
-void bcp_DoBCLExpandWithOffSet(bcp p, bcl l, bcl off);  // this operation does not do any SCC or MCC
+void bcp_DoBCLExpandWithOffSet(bcp p, bcl l, bcl off);  // replace each cube by a prime (blocking matrix), includes SCC
 void bcp_DoBCLExpandWithCofactor(bcp p, bcl l);
 
 /* bclminimize.c */
@@ -282,6 +486,21 @@ void bcp_DoBCLExpandWithCofactor(bcp p, bcl l);
 void bcp_MinimizeBCL(bcp p, bcl l);                             // minimize l
 void bcp_MinimizeBCLWithOnSet(bcp p, bcl l);
 
+/* bclespresso.c */
+
+#define BCP_MINIMIZE_MODE_DEFAULT 0     // SCC, cofactor expand, SCC and irredundant
+#define BCP_MINIMIZE_MODE_ESPRESSO 1    // REDUCE, EXPAND and IRREDUNDANT loop with off-set
+#define BCP_MINIMIZE_MODE_EXACT 2       // all primes and exact covering, see bclexact.c
+int bcp_GetMinimizeModeByName(const char *name);        // returns -1 for unknown names
+int bcp_GetBCLLiteralCnt(bcp p, bcl l);
+int bcp_DoBCLReduce(bcp p, bcl l);              // returns 0 for memory error or budget exceeded
+void bcp_MinimizeBCLWithEspresso(bcp p, bcl l);
+
+/* bclexact.c */
+
+bcl bcp_NewBCLPrimes(bcp p, bcl l);             // all primes, returns NULL for memory error or if the budget is exceeded
+int bcp_MinimizeBCLExact(bcp p, bcl l);         // returns 1 if the result is minimal, 0 if the heuristic has been used
+
 /* bcexpression.c */
 
 /*
@@ -331,6 +550,7 @@ char *bcp_GetExpressionBCL(bcp p, bcl l);       // convert "l" to a human readab
 int bcl_ExcludeBCLVars(bcp p, bcl l, bcl grp);                  // obsolete, replaced by bcp_DoBCLExcludeGroup()
 int bcp_DoBCLExcludeGroup(bcp p, bcl l, bc grp);                // 
 int bcp_DoBCLExcludeGroupList(bcp p, bcl l, bcl grp_list);
+int bcp_IsCubeXGroupEmpty(bcp p, bc c, bcl work);      // 1 if bcp_DoBCLXGroup() would remove "c", -1 for memory error
 int bcp_DoBCLXGroup(bcp p, bcl l);
 
 
@@ -12,7 +12,7 @@
   
   
   contains function function which 
-    - require calls to "bcp_CalcBCLBinateSplitVariableTable"
+    - calculate the number of zeros and ones for each variable (column statistics)
     - calculate the cofactor
     - find the right variable to do a recursiv split with help of a cofactor
 
@@ -20,58 +20,77 @@
 
 #include "bc.h"
 #include <assert.h>
+#include <stdlib.h>
+#include <string.h>
 
 
 
-/* 16 bit version */
-void bcp_CalcBCLBinateSplitVariableTable(bcp p, bcl l)
+/*
+  column statistics: number of zeros and ones for each variable
+
+  The counters are stored in a table with bcp_GetVarCntListSize(p) 32 bit entries: 
+  The first half contains the number of zeros, the second half contains the number of ones.
+  Within a block of 64 variables, the counters are stored in the order of the SIMD 
+  registers below, use bcp_GetVarCntZeroPos() and bcp_GetVarCntOnePos() to access 
+  the counter of a variable.
+  
+  A list (bcl) has its own table (l->var_cnt_list), which is only recalculated if the 
+  list has been modified (l->is_var_cnt_valid is 0). Cofactor operations update the 
+  table by subtracting the removed or changed cubes.
+  
+  Counting is done with 16 bit SIMD counters, which are added to the 32 bit table
+  after at most 0xffff cubes.
+*/
+
+#define BCP_VAR_CNT_CHUNK 0xffff
+
+/* store or add the eight 16 bit counters of "c" to the 32 bit counters at "dest" */
+static void bcp_store_var_cnt(uint32_t *dest, __m128i c, int is_add)
+{
+  __m128i lo = _mm_unpacklo_epi16(c, _mm_setzero_si128());
+  __m128i hi = _mm_unpackhi_epi16(c, _mm_setzero_si128());
+  if ( is_add )
+  {
+    lo = _mm_add_epi32(lo, _mm_loadu_si128((__m128i *)dest));
+    hi = _mm_add_epi32(hi, _mm_loadu_si128((__m128i *)(dest+4)));
+  }
+  _mm_storeu_si128((__m128i *)dest, lo);
+  _mm_storeu_si128((__m128i *)(dest+4), hi);
+}
+
+/* 
+  calculate the table for the "list_cnt" cubes in "rows" or, if "rows" is NULL, the non-deleted cubes of "l" 
+*/
+static void bcp_calc_var_cnt_table(bcp p, bcl l, bc *rows, int list_cnt, uint32_t *var_cnt_list)
 {
 	int i, blk_cnt = p->blk_cnt;
-	int j, list_cnt = l->cnt;
-	
-	bc zero_cnt_cube[8];
-	bc one_cnt_cube[8];
-	
+	int j, chunk_start, chunk_end;
+	int is_add;
+	bc cube;
+	uint32_t *zero;
+	uint32_t *one;
 
 	__m128i c;  // current block from the current cube from the list
 	__m128i t;	// temp block
 	__m128i oc0, oc1, oc2, oc3, oc4, oc5, oc6, oc7;	// one count
 	__m128i zc0, zc1, zc2, zc3, zc4, zc5, zc6, zc7;	// zero count
-	__m128i mc; // mask cube for the lowest bit in each byte
-
-	/* constuct the byte mask: we need the lowest bit of each byte */
-	mc = _mm_setzero_si128();
-	mc = _mm_insert_epi16(mc, 1, 0);
-	mc = _mm_insert_epi16(mc, 1, 1);
-	mc = _mm_insert_epi16(mc, 1, 2);
-	mc = _mm_insert_epi16(mc, 1, 3);
-	mc = _mm_insert_epi16(mc, 1, 4);
-	mc = _mm_insert_epi16(mc, 1, 5);
-	mc = _mm_insert_epi16(mc, 1, 6);
-	mc = _mm_insert_epi16(mc, 1, 7);
-
-	/* "misuse" the cubes as SIMD storage area for the counters */
-	zero_cnt_cube[0] = bcp_GetGlobalCube(p, 4);
-	zero_cnt_cube[1] = bcp_GetGlobalCube(p, 5);
-	zero_cnt_cube[2] = bcp_GetGlobalCube(p, 6);
-	zero_cnt_cube[3] = bcp_GetGlobalCube(p, 7);
-	zero_cnt_cube[4] = bcp_GetGlobalCube(p, 8);
-	zero_cnt_cube[5] = bcp_GetGlobalCube(p, 9);
-	zero_cnt_cube[6] = bcp_GetGlobalCube(p, 10);
-	zero_cnt_cube[7] = bcp_GetGlobalCube(p, 11);
-	
-	one_cnt_cube[0] = bcp_GetGlobalCube(p, 12);
-	one_cnt_cube[1] = bcp_GetGlobalCube(p, 13);
-	one_cnt_cube[2] = bcp_GetGlobalCube(p, 14);
-	one_cnt_cube[3] = bcp_GetGlobalCube(p, 15);
-	one_cnt_cube[4] = bcp_GetGlobalCube(p, 16);
-	one_cnt_cube[5] = bcp_GetGlobalCube(p, 17);
-	one_cnt_cube[6] = bcp_GetGlobalCube(p, 18);
-	one_cnt_cube[7] = bcp_GetGlobalCube(p, 19);
-	
+	__m128i mc; // mask cube for the lowest bit in each 16 bit word
+
+	mc = _mm_set1_epi16(1);
+
 	/* loop over the blocks */
 	for( i = 0; i < blk_cnt; i++ )
 	{
+	  zero = var_cnt_list + i*64;
+	  one = var_cnt_list + blk_cnt*64 + i*64;
+	  is_add = 0;
+	  chunk_start = 0;
+	  do
+	  {
+		chunk_end = chunk_start + BCP_VAR_CNT_CHUNK;
+		if ( chunk_end > list_cnt )
+		  chunk_end = list_cnt;
+		
 		/* clear all the conters for the current block */
 		zc0 = _mm_setzero_si128();
 		zc1 = _mm_setzero_si128();
@@ -90,21 +109,24 @@ void bcp_CalcBCLBinateSplitVariableTable(bcp p, bcl l)
 		oc6 = _mm_setzero_si128();
 		oc7 = _mm_setzero_si128();
 		
-		for( j = 0; j < list_cnt; j++ )
+		for( j = chunk_start; j < chunk_end; j++ )
 		{
-                  if ( l->flags[j] == 0 )
+                  if ( rows != NULL )
+                    cube = rows[j];
+                  else if ( l->flags[j] == 0 )
+                    cube = bcp_GetBCLCube(p, l, j);
+                  else
+                    cube = NULL;
+                  if ( cube != NULL )
                   {
 			/*
 				Goal: 
 					Count, how often 01 (zero) and 10 (one) do appear in the list at a specific cube position
 					This means, for a cube with x variables, we will generate 2*x numbers
 					For this count we have to ignore 11 (don't care) values.
-				Assumption:
-					The code 00 (illegal) is assumed to be absent.
 				Idea:
-					Because only code 11, 01 and 10 will be there in the cubes, it will be good enough
-					to count the 0 bits from 01 and 10.
-					Each counter will be 8 bit only (hoping that this is enough) with satuartion at 255 (thanks to SIMD instructions)
+					It is good enough to count the 0 bits from 01 and 10 (an illegal 00 is counted as zero and one).
+					Each counter has 16 bit, the chunk size makes sure, that there is no overflow.
 					In order to add or not add the above "0" (from the 01 or 10 code) to the counter, we will just mask and invert the 0 bit.
 				
 				Example:
@@ -112,314 +134,290 @@ void bcp_CalcBCLBinateSplitVariableTable(bcp p, bcl l)
 						xxxxxx10		code for value "one" at bits 0/1
 					this is inverted and masked with one SIMD instruction:
 						00000001		increment value for the counter
-					this value is then added (with sturation) to the "one" counter 
+					this value is then added to the "one" counter 
 					if, on the other hand, there would be a don't care or zero, it would look like this:
 						xxxxxx01		code for value "zero" at bits 0/1
 						xxxxxx11		code for value "don't care" at bits 0/1
-					the invert and mask operation for bit 0 will generate a 0 byte in both cases:
+					the invert and mask operation for bit 0 will generate a 0 in both cases:
 						00000000		increment value for the counter in case of "zero" and "don't care" value
 			*/
-			c = _mm_loadu_si128(bcp_GetBCLCube(p, l, j)+i);
+			c = _mm_loadu_si128(cube+i);
 			/* handle variable at bits 0/1 */
-			t = _mm_andnot_si128(c, mc);		// flip the lowerst bit and mask the lowerst bit in each byte: the "10" code for value "one" will become "00000001"
-			oc0 = _mm_adds_epi16(oc0, t);		// sum the "one" value with saturation
+			t = _mm_andnot_si128(c, mc);		// flip the lowerst bit and mask the lowerst bit in each word: the "10" code for value "one" will become "00000001"
+			oc0 = _mm_add_epi16(oc0, t);		// sum the "one" value
 			c = _mm_srai_epi16(c,1);			// shift right to proceed with the "zero" value
 			t = _mm_andnot_si128(c, mc);
-			zc0 = _mm_adds_epi16(zc0, t);
+			zc0 = _mm_add_epi16(zc0, t);
 			
 			c = _mm_srai_epi16(c,1);			// shift right to process the next variable
 
 			/* handle variable at bits 2/3 */
 			t = _mm_andnot_si128(c, mc);
-			oc1 = _mm_adds_epi16(oc1, t);
+			oc1 = _mm_add_epi16(oc1, t);
 			c = _mm_srai_epi16(c,1);
 			t = _mm_andnot_si128(c, mc);
-			zc1 = _mm_adds_epi16(zc1, t);
+			zc1 = _mm_add_epi16(zc1, t);
 
 			c = _mm_srai_epi16(c,1);
 
 			/* handle variable at bits 4/5 */
 			t = _mm_andnot_si128(c, mc);
-			oc2 = _mm_adds_epi16(oc2, t);
+			oc2 = _mm_add_epi16(oc2, t);
 			c = _mm_srai_epi16(c,1);
 			t = _mm_andnot_si128(c, mc);
-			zc2 = _mm_adds_epi16(zc2, t);
+			zc2 = _mm_add_epi16(zc2, t);
 
 			c = _mm_srai_epi16(c,1);
 
 			/* handle variable at bits 6/7 */
 			t = _mm_andnot_si128(c, mc);
-			oc3 = _mm_adds_epi16(oc3, t);
+			oc3 = _mm_add_epi16(oc3, t);
 			c = _mm_srai_epi16(c,1);
 			t = _mm_andnot_si128(c, mc);
-			zc3 = _mm_adds_epi16(zc3, t);
+			zc3 = _mm_add_epi16(zc3, t);
                         
 			c = _mm_srai_epi16(c,1);
 
 			/* handle variable at bits 8/9 */
 			t = _mm_andnot_si128(c, mc);
-			oc4 = _mm_adds_epi16(oc4, t);
+			oc4 = _mm_add_epi16(oc4, t);
 			c = _mm_srai_epi16(c,1);
 			t = _mm_andnot_si128(c, mc);
-			zc4 = _mm_adds_epi16(zc4, t);
+			zc4 = _mm_add_epi16(zc4, t);
                         
 			c = _mm_srai_epi16(c,1);
 
 			/* handle variable at bits 10/11 */
 			t = _mm_andnot_si128(c, mc);
-			oc5 = _mm_adds_epi16(oc5, t);
+			oc5 = _mm_add_epi16(oc5, t);
 			c = _mm_srai_epi16(c,1);
 			t = _mm_andnot_si128(c, mc);
-			zc5 = _mm_adds_epi16(zc5, t);
+			zc5 = _mm_add_epi16(zc5, t);
                         
 			c = _mm_srai_epi16(c,1);
 
 			/* handle variable at bits 12/13 */
 			t = _mm_andnot_si128(c, mc);
-			oc6 = _mm_adds_epi16(oc6, t);
+			oc6 = _mm_add_epi16(oc6, t);
 			c = _mm_srai_epi16(c,1);
 			t = _mm_andnot_si128(c, mc);
-			zc6 = _mm_adds_epi16(zc6, t);
+			zc6 = _mm_add_epi16(zc6, t);
                         
 			c = _mm_srai_epi16(c,1);
 
 			/* handle variable at bits 14/15 */
 			t = _mm_andnot_si128(c, mc);
-			oc7 = _mm_adds_epi16(oc7, t);
+			oc7 = _mm_add_epi16(oc7, t);
 			c = _mm_srai_epi16(c,1);
 			t = _mm_andnot_si128(c, mc);
-			zc7 = _mm_adds_epi16(zc7, t);
+			zc7 = _mm_add_epi16(zc7, t);
                   }  // flag test
 		
                 } // j, list loop
-		/* store the registers for counting zeros and ones */
-		_mm_storeu_si128(zero_cnt_cube[0] + i, zc0);
-		_mm_storeu_si128(zero_cnt_cube[1] + i, zc1);
-		_mm_storeu_si128(zero_cnt_cube[2] + i, zc2);
-		_mm_storeu_si128(zero_cnt_cube[3] + i, zc3);
-		_mm_storeu_si128(zero_cnt_cube[4] + i, zc4);
-		_mm_storeu_si128(zero_cnt_cube[5] + i, zc5);
-		_mm_storeu_si128(zero_cnt_cube[6] + i, zc6);
-		_mm_storeu_si128(zero_cnt_cube[7] + i, zc7);
 		
-		_mm_storeu_si128(one_cnt_cube[0] + i, oc0);
-		_mm_storeu_si128(one_cnt_cube[1] + i, oc1);
-		_mm_storeu_si128(one_cnt_cube[2] + i, oc2);
-		_mm_storeu_si128(one_cnt_cube[3] + i, oc3);
-		_mm_storeu_si128(one_cnt_cube[4] + i, oc4);
-		_mm_storeu_si128(one_cnt_cube[5] + i, oc5);
-		_mm_storeu_si128(one_cnt_cube[6] + i, oc6);
-		_mm_storeu_si128(one_cnt_cube[7] + i, oc7);
-	
-        /* 
-          based on the calculated number of "one" and "zero" values, find a variable which fits best for splitting.
-          According to R. Rudell in "Multiple-Valued Logic Minimization for PLA Synthesis" this should be the
-          variable with the highest value of one_cnt + zero_cnt
-        */
-      } // i, block loop
+		/* add the 16 bit counters to the table: word w of register k contains the variable i*64 + w*8 + k */
+		bcp_store_var_cnt(zero + 0*8, zc0, is_add);
+		bcp_store_var_cnt(zero + 1*8, zc1, is_add);
+		bcp_store_var_cnt(zero + 2*8, zc2, is_add);
+		bcp_store_var_cnt(zero + 3*8, zc3, is_add);
+		bcp_store_var_cnt(zero + 4*8, zc4, is_add);
+		bcp_store_var_cnt(zero + 5*8, zc5, is_add);
+		bcp_store_var_cnt(zero + 6*8, zc6, is_add);
+		bcp_store_var_cnt(zero + 7*8, zc7, is_add);
+		
+		bcp_store_var_cnt(one + 0*8, oc0, is_add);
+		bcp_store_var_cnt(one + 1*8, oc1, is_add);
+		bcp_store_var_cnt(one + 2*8, oc2, is_add);
+		bcp_store_var_cnt(one + 3*8, oc3, is_add);
+		bcp_store_var_cnt(one + 4*8, oc4, is_add);
+		bcp_store_var_cnt(one + 5*8, oc5, is_add);
+		bcp_store_var_cnt(one + 6*8, oc6, is_add);
+		bcp_store_var_cnt(one + 7*8, oc7, is_add);
+		is_add = 1;
+		chunk_start = chunk_end;
+	  } while( chunk_start < list_cnt );
+	} // i, block loop
 }
 
-/*
-  Precondition: call to 
-    void bcp_CalcBCLBinateSplitVariableTable(bcp p, bcl l)  
+/* 
+  add (dir = 1) or subtract (dir = -1) the literals of cube "c" to the table. 
+  "c" may contain illegal variables, which are counted as zero and one 
+*/
+void bcp_AddCubeVarCnt(bcp p, bc c, uint32_t *var_cnt_list, int dir)
+{
+  int i, v;
+  uint64_t w, x;
+  const uint64_t *u = (const uint64_t *)c;
+  uint32_t *one = var_cnt_list + p->blk_cnt*64;
+  
+  for( i = 0; i < p->blk_cnt*2; i++ )
+  {
+    x = u[i];
+    w = ~(x >> 1) & 0x5555555555555555ULL;   // bit 1 of the variable is 0: zero (01) or illegal
+    while( w != 0 )
+    {
+      v = i*32 + __builtin_ctzll(w)/2;
+      var_cnt_list[bcp_GetVarCntZeroPos(p, v)] += dir;
+      w &= w-1;
+    }
+    w = ~x & 0x5555555555555555ULL;  // bit 0 of the variable is 0: one (10) or illegal
+    while( w != 0 )
+    {
+      v = i*32 + __builtin_ctzll(w)/2;
+      one[bcp_GetVarCntZeroPos(p, v)] += dir;
+      w &= w-1;
+    }
+  }
+}
 
-  returns the binate variable for which the number of one's plus number of zero's is max under the condition, that both number of once's and zero's are >0 
+/* calculate the table for an array of cube pointers */
+void bcp_CalcRowsVarCnt(bcp p, bc *rows, int cnt, uint32_t *var_cnt_list)
+{
+  bcp_calc_var_cnt_table(p, NULL, rows, cnt, var_cnt_list);
+}
 
-  Implementation without SSE2
+/*
+  returns the binate variable for which the number of one's plus number of zero's is max 
+  under the condition, that both number of once's and zero's are >0 
+  returns -1 if all variables are unate.
+  If there are several variables with the same count, then the lowest variable is returned.
+  
+  SSE2 Implementation: Each 32 bit lane of max_sum collects the maximum for the variables 
+  b*64 + w*8 + k with a fixed "w". The variables of a lane are visited in increasing order.
 */
-
-/* 16 bit version */
-int bcp_GetBCLMaxBinateSplitVariableSimple(bcp p, bcl l)
+int bcp_GetMaxBinateSplitVariableByVarCnt(bcp p, const uint32_t *var_cnt_list)
 {
-  int max_sum_cnt = -1;
+  int b, k, h, w;
   int max_sum_var = -1;
-  int cube_idx;
-  int blk_idx;
-  int word_idx;
-  int one_cnt;
-  int zero_cnt;
+  uint32_t max_sum_cnt = 0;
+  const uint32_t *zero = var_cnt_list;
+  const uint32_t *one = var_cnt_list + p->blk_cnt*64;
+  __m128i sign = _mm_set1_epi32((int)0x80000000);        // unsigned compare with the signed compare instruction
+  __m128i max_sum[2];
+  __m128i max_idx[2];
+  __m128i z, o, sum, cmp, idx;
+  uint32_t m_sum[8];
+  uint32_t m_idx[8];
   
-  int i;
-  
-  bc zero_cnt_cube[8];
-  bc one_cnt_cube[8];
-
-  /* "misuse" the cubes as SIMD storage area for the counters */
-  zero_cnt_cube[0] = bcp_GetGlobalCube(p, 4);
-  zero_cnt_cube[1] = bcp_GetGlobalCube(p, 5);
-  zero_cnt_cube[2] = bcp_GetGlobalCube(p, 6);
-  zero_cnt_cube[3] = bcp_GetGlobalCube(p, 7);
-  zero_cnt_cube[4] = bcp_GetGlobalCube(p, 8);
-  zero_cnt_cube[5] = bcp_GetGlobalCube(p, 9);
-  zero_cnt_cube[6] = bcp_GetGlobalCube(p, 10);
-  zero_cnt_cube[7] = bcp_GetGlobalCube(p, 11);
-  
-  one_cnt_cube[0] = bcp_GetGlobalCube(p, 12);
-  one_cnt_cube[1] = bcp_GetGlobalCube(p, 13);
-  one_cnt_cube[2] = bcp_GetGlobalCube(p, 14);
-  one_cnt_cube[3] = bcp_GetGlobalCube(p, 15);
-  one_cnt_cube[4] = bcp_GetGlobalCube(p, 16);
-  one_cnt_cube[5] = bcp_GetGlobalCube(p, 17);
-  one_cnt_cube[6] = bcp_GetGlobalCube(p, 18);
-  one_cnt_cube[7] = bcp_GetGlobalCube(p, 19);
-
+  for( h = 0; h < 2; h++ )
+  {
+    max_sum[h] = sign;          // biased zero
+    max_idx[h] = _mm_setzero_si128();
+  }
+  for( b = 0; b < p->blk_cnt; b++ )
+  {
+    for( k = 0; k < 8; k++ )
+    {
+      idx = _mm_set1_epi32(b*64 + k);
+      for( h = 0; h < 2; h++ )
+      {
+        z = _mm_loadu_si128((__m128i *)(zero + b*64 + k*8 + h*4));
+        o = _mm_loadu_si128((__m128i *)(one + b*64 + k*8 + h*4));
+        // if either count is zero, then the sum is set to zero, because we don't want any index on unate variables
+        cmp = _mm_or_si128(_mm_cmpeq_epi32(z, _mm_setzero_si128()), _mm_cmpeq_epi32(o, _mm_setzero_si128()));
+        sum = _mm_xor_si128(_mm_andnot_si128(cmp, _mm_add_epi32(z, o)), sign);
+        cmp = _mm_cmpgt_epi32(sum, max_sum[h]);
+        max_sum[h] = _mm_or_si128(_mm_andnot_si128(cmp, max_sum[h]), _mm_and_si128(cmp, sum));
+        max_idx[h] = _mm_or_si128(_mm_andnot_si128(cmp, max_idx[h]), _mm_and_si128(cmp, idx));
+      }
+    }
+  }
   
-  max_sum_cnt = -1;
-  max_sum_var = -1;
-  for( i = 0; i < p->var_cnt; i++ )
+  _mm_storeu_si128((__m128i *)m_sum, _mm_xor_si128(max_sum[0], sign));
+  _mm_storeu_si128((__m128i *)(m_sum+4), _mm_xor_si128(max_sum[1], sign));
+  _mm_storeu_si128((__m128i *)m_idx, max_idx[0]);
+  _mm_storeu_si128((__m128i *)(m_idx+4), max_idx[1]);
+  for( w = 0; w < 8; w++ )
   {
-          cube_idx = i & 7;
-          blk_idx = i / 64;
-          word_idx = (i & 63)>>3;
-          one_cnt = ((uint16_t *)(one_cnt_cube[cube_idx] + blk_idx))[word_idx];
-          zero_cnt = ((uint16_t *)(zero_cnt_cube[cube_idx] + blk_idx))[word_idx];
-          //printf("%02x/%02x ", one_cnt, zero_cnt);
-    
-          if ( one_cnt > 0 && zero_cnt > 0 )
-          {
-            if ( max_sum_cnt < (one_cnt + zero_cnt) )
-            {
-                    max_sum_cnt = one_cnt + zero_cnt;
-                    max_sum_var = i;
-            }
-          }
-  }  
-  //printf("\n");
+    if ( m_sum[w] == 0 )
+      continue;
+    k = m_idx[w] + w*8;         // variable
+    if ( max_sum_cnt < m_sum[w] || ( max_sum_cnt == m_sum[w] && k < max_sum_var ) )
+    {
+      max_sum_cnt = m_sum[w];
+      max_sum_var = k;
+    }
+  }
   return max_sum_var;
 }
 
-
-
 /*
-  Precondition: call to 
-    void bcp_CalcBCLBinateSplitVariableTable(bcp p, bcl l)  
+  calculate the table of "l", if "l" has been modified since the last calculation.
+  returns 0 for memory error
+*/
+int bcp_CalcBCLBinateSplitVariableTable(bcp p, bcl l)
+{
+  if ( l->var_cnt_list == NULL )
+  {
+    l->var_cnt_list = (uint32_t *)malloc(bcp_GetVarCntListSize(p)*sizeof(uint32_t));
+    if ( l->var_cnt_list == NULL )
+      return 0;
+    l->is_var_cnt_valid = 0;
+  }
+  if ( l->is_var_cnt_valid == 0 )
+  {
+    bcp_calc_var_cnt_table(p, l, NULL, l->cnt, l->var_cnt_list);
+    l->is_var_cnt_valid = 1;
+  }
+  return 1;
+}
 
-  returns the binate variable for which the number of one's plus number of zero's is max under the condition, that both number of once's and zero's are >0 
+/*
+  returns the binate variable for which the number of one's plus number of zero's is max 
+  under the condition, that both number of once's and zero's are >0 
 
-  SSE2 Implementation
+  This is a reference implementation, which does not use the table of "l"
 */
-/* 16 bit version */
-int bcp_GetBCLMaxBinateSplitVariable(bcp p, bcl l)
+int bcp_GetBCLMaxBinateSplitVariableSimple(bcp p, bcl l)
 {
   int max_sum_cnt = -1;
   int max_sum_var = -1;
-  int i, b;
-  __m128i c;
-  __m128i z;
-  __m128i o;
-  
-  __m128i c_cmp = _mm_setzero_si128();
-  __m128i c_max = _mm_setzero_si128();
-  __m128i c_idx = _mm_setzero_si128();
-  __m128i c_max_idx = _mm_setzero_si128();
-  
-  uint16_t m_base_idx[8] = { 0, 8, 16, 24,  32, 40, 48, 56 };
-  uint16_t m_base_inc[8] = { 1, 1, 1, 1,   1, 1, 1, 1 };
-  
-  uint16_t m_idx[8];
-  uint16_t m_max[8];
-  
-  bc zero_cnt_cube[8];
-  bc one_cnt_cube[8];
-
-  if ( l->cnt == 0 )
-    return -1;
-
-  /* "misuse" the cubes as SIMD storage area for the counters */
-  zero_cnt_cube[0] = bcp_GetGlobalCube(p, 4);
-  zero_cnt_cube[1] = bcp_GetGlobalCube(p, 5);
-  zero_cnt_cube[2] = bcp_GetGlobalCube(p, 6);
-  zero_cnt_cube[3] = bcp_GetGlobalCube(p, 7);
-  zero_cnt_cube[4] = bcp_GetGlobalCube(p, 8);
-  zero_cnt_cube[5] = bcp_GetGlobalCube(p, 9);
-  zero_cnt_cube[6] = bcp_GetGlobalCube(p, 10);
-  zero_cnt_cube[7] = bcp_GetGlobalCube(p, 11);
+  int one_cnt;
+  int zero_cnt;
+  int i, j;
+  unsigned v;
   
-  one_cnt_cube[0] = bcp_GetGlobalCube(p, 12);
-  one_cnt_cube[1] = bcp_GetGlobalCube(p, 13);
-  one_cnt_cube[2] = bcp_GetGlobalCube(p, 14);
-  one_cnt_cube[3] = bcp_GetGlobalCube(p, 15);
-  one_cnt_cube[4] = bcp_GetGlobalCube(p, 16);
-  one_cnt_cube[5] = bcp_GetGlobalCube(p, 17);
-  one_cnt_cube[6] = bcp_GetGlobalCube(p, 18);
-  one_cnt_cube[7] = bcp_GetGlobalCube(p, 19);
-
-  for( b = 0; b < p->blk_cnt; b++ )
+  for( i = 0; i < p->var_cnt; i++ )
   {
-      c_idx = _mm_loadu_si128((__m128i *)m_base_idx);
-      c_max = _mm_setzero_si128();
-      c_max_idx = _mm_setzero_si128();
-    
-      for( i = 0; i < 8; i++ )
+    one_cnt = 0;
+    zero_cnt = 0;
+    for( j = 0; j < l->cnt; j++ )
+    {
+      if ( l->flags[j] == 0 )
       {
-        z = _mm_loadu_si128(zero_cnt_cube[i]+b);
-        o = _mm_loadu_si128(one_cnt_cube[i]+b);
-
-        /*
-        printf("a%d: ", i);
-        print128_num(o);
-        
-        printf("a%d: ", i);
-        print128_num(z);
-        */
-        
-        // idea: if either count is zero, then set also the other count to zero
-        // because we don't want any index on unate variables, we clear both counts if one count is zero
-        c = _mm_cmpeq_epi16(z, _mm_setzero_si128());     // check for zero count of zeros
-        o = _mm_andnot_si128 (c, o);                                    // and clear the one count if the zero count is zero
-        c = _mm_cmpeq_epi16(o, _mm_setzero_si128());     // check for zero count of ones
-        z = _mm_andnot_si128 (c, z);                                    // and clear the zero count if the one count is zero
-
-        /*
-        printf("b     %d: ", i);
-        print128_num(o);
-        
-        printf("b     %d: ", i);
-        print128_num(z);
-        */
-        
-        // at this point either both o and z are zero or both are not zero        
-        // now, calculate the sum of both counts and store the sum in z, o is not required any more
-        z = _mm_adds_epi16(z, o);
-
-        /*
-        printf("z     %d: ", i);
-        print128_num(z);
-        */
-        
-        c_cmp = _mm_cmplt_epi16( c_max, z );
-
-        c_max = _mm_or_si128( _mm_andnot_si128(c_cmp, c_max), _mm_and_si128(c_cmp, z) );                        // update max value if required
-        c_max_idx = _mm_or_si128( _mm_andnot_si128(c_cmp, c_max_idx), _mm_and_si128(c_cmp, c_idx) );    // update index value if required        
-        
-        c_idx = _mm_adds_epu16(c_idx, _mm_loadu_si128((__m128i *)m_base_inc));   // we just add 1 to the value, so the highest value per byte is 64
+        v = bcp_GetCubeVar(p, bcp_GetBCLCube(p, l, j), i);
+        if ( (v & 1) == 0 )
+          one_cnt++;
+        if ( (v & 2) == 0 )
+          zero_cnt++;
       }
-      
-      _mm_storeu_si128( (__m128i *)m_max, c_max );
-      _mm_storeu_si128( (__m128i *)m_idx, c_max_idx );
-      for( i = 0; i < 8; i++ )
-        if ( m_max[i] > 0 )
-          if ( max_sum_cnt < m_max[i] )
-          {
-            max_sum_cnt = m_max[i];
-            max_sum_var = m_idx[i] + b*p->vars_per_blk_cnt;
-          }
-  }
-  
-  /*
-  {
-    int mv = bcp_GetBCLMaxBinateSplitVariableSimple(p, l);
-    if ( max_sum_var != mv )
+    }
+    if ( one_cnt > 0 && zero_cnt > 0 )
     {
-      printf("failed max_sum_var=%d, mv=%d\n", max_sum_var, mv);
-      //bcp_ShowBCL(p, l);
+      if ( max_sum_cnt < (one_cnt + zero_cnt) )
+      {
+        max_sum_cnt = one_cnt + zero_cnt;
+        max_sum_var = i;
+      }
     }
-  }
-  */
-  
+  }  
   return max_sum_var;
 }
 
+/*
+  returns the binate variable for which the number of one's plus number of zero's is max under the condition, 
+  that both number of once's and zero's are >0 
+  The table of "l" is calculated if required.
+*/
+int bcp_GetBCLMaxBinateSplitVariable(bcp p, bcl l)
+{
+  if ( l->cnt == 0 )
+    return -1;
+  if ( bcp_CalcBCLBinateSplitVariableTable(p, l) == 0 )
+    return bcp_GetBCLMaxBinateSplitVariableSimple(p, l);
+  return bcp_GetMaxBinateSplitVariableByVarCnt(p, l->var_cnt_list);
+}
+
 
 
 
@@ -431,6 +429,7 @@ int bcp_GetBCLMaxBinateSplitVariable(bcp p, bcl l)
 /*
   with the cube at postion "pos" within "l", check whether there are any other cubes, which are a subset of the cobe at postion "pos"
   The cubes, which are marked as subset are not deleted. This should done by a later call to bcp_BCLPurge()
+  If the table of "l" is valid, then the marked cubes are removed from the table.
 */
 static void bcp_DoBCLSubsetCubeMark(bcp p, bcl l, int pos)
 {
@@ -450,6 +449,8 @@ static void bcp_DoBCLSubsetCubeMark(bcp p, bcl l, int pos)
       if ( bcp_IsSubsetCube(p, c, bcp_GetBCLCube(p, l, j)) != 0 )
       {
         l->flags[j] = 1;      // mark the j cube as covered (to be deleted)
+        if ( l->is_var_cnt_valid )
+          bcp_AddCubeVarCnt(p, bcp_GetBCLCube(p, l, j), l->var_cnt_list, -1);
       }            
     }
   }  
@@ -515,12 +516,14 @@ int bcp_IsBCLVariableUnate(bcp p, bcl l, unsigned var_pos, unsigned value)
   "value" must be either 1 (zero) or 2 (one)
   
   This function will update and modify the list "l"
+  A valid table of "l" is updated and remains valid.
 
 */
 void bcp_DoBCLOneVariableCofactor(bcp p, bcl l, unsigned var_pos, unsigned value)
 {
   int i;
   int cnt = l->cnt;
+  int is_var_cnt_valid = l->is_var_cnt_valid;
   unsigned v;
   bc c;
   
@@ -538,6 +541,13 @@ void bcp_DoBCLOneVariableCofactor(bcp p, bcl l, unsigned var_pos, unsigned value
       {
         if ( (v | value) == 3 ) // if no, then check if the variable would become don't care
         {
+          if ( is_var_cnt_valid )
+          {
+            if ( (v & 1) == 0 )
+              l->var_cnt_list[bcp_GetVarCntOnePos(p, var_pos)]--;        // remove one
+            if ( (v & 2) == 0 )
+              l->var_cnt_list[bcp_GetVarCntZeroPos(p, var_pos)]--;       // remove zero
+          }
           bcp_SetCubeVar(p, c, var_pos, 3);   // yes, variable will become don't care
           bcp_DoBCLSubsetCubeMark(p, l, i);
         } // check for "becomes don't care'
@@ -545,6 +555,7 @@ void bcp_DoBCLOneVariableCofactor(bcp p, bcl l, unsigned var_pos, unsigned value
     }
   } // i loop
   bcp_PurgeBCL(p, l);  // cleanup for bcp_DoBCLSubsetCubeMark()
+  l->is_var_cnt_valid = is_var_cnt_valid;       // the table has been updated above
 }
 
 /*
@@ -578,6 +589,7 @@ void bcp_DoBCLCofactorByCube(bcp p, bcl l, bc c, int exclude)
   
   dc = _mm_loadu_si128(bcp_GetGlobalCube(p, 3));
   
+  bcp_InvalidateBCLVarCnt(p, l);
   if ( exclude >= 0 )
     l->flags[exclude] = 1;
   
@@ -610,106 +622,102 @@ bcl bcp_NewBCLCofactorByCube(bcp p, bcl l, bc c, int exclude)
   return n;
 }
 
-
 /*
-  Precondition: call to 
-    void bcp_CalcBCLBinateSplitVariableTable(bcp p, bcl l) 
+  Calculate the cofactor of l against c, but use only the cubes of l, which 
+  intersect with c: All other cubes do not contribute to the cofactor.
+  No single cube containment is applied to the result.
+  c must not be illegal, the cube at position exclude is ignored (exclude can be negative)
+
+  returns a new list, which must be freed with bcp_DeleteBCL() or NULL for memory error
+  Special cases:
+    - a cube of l contains c: the result only has the tautology cube (c is covered)
+    - no cube of l intersects with c: the result is empty (c is not covered)
+*/
+bcl bcp_NewBCLIntersectingCofactorByCube(bcp p, bcl l, bc c, int exclude)
+{
+  int i, b, pos;
+  bc lc;
+  __m128i cc, t, zero, notsub;
+  __m128i m55 = _mm_set1_epi8(0x55);
+  __m128i dc = _mm_loadu_si128(bcp_GetGlobalCube(p, 3));
+  bcl n = bcp_NewBCL(p);
+  if ( n == NULL )
+    return NULL;
+  
+  for( i = 0; i < l->cnt; i++ )
+  {
+    if ( l->flags[i] != 0 || i == exclude )
+      continue;
+    lc = bcp_GetBCLCube(p, l, i);
+    zero = _mm_setzero_si128();
+    notsub = _mm_setzero_si128();
+    for( b = 0; b < p->blk_cnt; b++ )
+    {
+      cc = _mm_loadu_si128(c+b);
+      t = _mm_and_si128(_mm_loadu_si128(lc+b), cc);
+      zero = _mm_or_si128(zero, _mm_andnot_si128(_mm_or_si128(t, _mm_srli_epi16(t, 1)), m55));  // 01 for each 00 in "lc & c"
+      notsub = _mm_or_si128(notsub, _mm_xor_si128(t, cc));              // nonzero if "c" is not a subset of "lc"
+    }
+    if ( _mm_movemask_epi8(_mm_cmpeq_epi8(zero, _mm_setzero_si128())) != 0x0ffff )
+      continue;         // no intersection
+    if ( _mm_movemask_epi8(_mm_cmpeq_epi8(notsub, _mm_setzero_si128())) == 0x0ffff )
+    {
+      /* "c" is a subset of "lc": the cofactor is the tautology cube */
+      bcp_ClearBCL(p, n);
+      if ( bcp_AddBCLCubeByCube(p, n, bcp_GetGlobalCube(p, 3)) < 0 )
+        return bcp_DeleteBCL(p, n), NULL;
+      return n;
+    }
+    pos = bcp_AddBCLCubeByCube(p, n, lc);
+    if ( pos < 0 )
+      return bcp_DeleteBCL(p, n), NULL;
+    lc = bcp_GetBCLCube(p, n, pos);
+    for( b = 0; b < p->blk_cnt; b++ )
+      _mm_storeu_si128(lc+b, _mm_or_si128(_mm_andnot_si128(_mm_loadu_si128(c+b), dc), _mm_loadu_si128(lc+b)));
+  }
+  return n;
+}
+
 
-  return 0 if there is any variable which has one's and "zero's in the table
+/*
+  return 0 if there is any variable which has one's and zero's in the list
   otherwise this function returns 1
 
-  16 bit version
+  If the table of "l" is valid, then the table is used. Otherwise the table is 
+  not calculated: Instead the variables with zero and one literal are collected 
+  until a binate variable is found.
 */
-int bcp_IsBCLUnate(bcp p)
+int bcp_IsBCLUnate(bcp p, bcl l)
 {
-  int b;
-  bc zero_cnt_cube[8];
-  bc one_cnt_cube[8];
-  __m128i z;
-  __m128i o;
-
-  /* "misuse" the cubes as SIMD storage area for the counters */
-  zero_cnt_cube[0] = bcp_GetGlobalCube(p, 4);
-  zero_cnt_cube[1] = bcp_GetGlobalCube(p, 5);
-  zero_cnt_cube[2] = bcp_GetGlobalCube(p, 6);
-  zero_cnt_cube[3] = bcp_GetGlobalCube(p, 7);
-  zero_cnt_cube[4] = bcp_GetGlobalCube(p, 8);
-  zero_cnt_cube[5] = bcp_GetGlobalCube(p, 9);
-  zero_cnt_cube[6] = bcp_GetGlobalCube(p, 10);
-  zero_cnt_cube[7] = bcp_GetGlobalCube(p, 11);
+  int i, j, b;
+  __m128i z, o, c;
+  const uint32_t *zero, *one;
+  
+  if ( l->var_cnt_list != NULL && l->is_var_cnt_valid != 0 )
+  {
+    zero = l->var_cnt_list;
+    one = l->var_cnt_list + p->blk_cnt*64;
+    for( i = 0; i < p->blk_cnt*64; i++ )
+      if ( zero[i] > 0 && one[i] > 0 )
+        return 0;
+    return 1;
+  }
   
-  one_cnt_cube[0] = bcp_GetGlobalCube(p, 12);
-  one_cnt_cube[1] = bcp_GetGlobalCube(p, 13);
-  one_cnt_cube[2] = bcp_GetGlobalCube(p, 14);
-  one_cnt_cube[3] = bcp_GetGlobalCube(p, 15);
-  one_cnt_cube[4] = bcp_GetGlobalCube(p, 16);
-  one_cnt_cube[5] = bcp_GetGlobalCube(p, 17);
-  one_cnt_cube[6] = bcp_GetGlobalCube(p, 18);
-  one_cnt_cube[7] = bcp_GetGlobalCube(p, 19);
-
   for( b = 0; b < p->blk_cnt; b++ )
   {
-        z = _mm_cmpeq_epi8(_mm_loadu_si128(zero_cnt_cube[0]+b), _mm_setzero_si128());     // 0 cnt becomes 0xff and all other values become 0x00
-        o = _mm_cmpeq_epi8(_mm_loadu_si128(one_cnt_cube[0]+b), _mm_setzero_si128());     // 0 cnt becomes 0xff and all other values become 0x00
-                       // if ones and zeros are present, then both values are 0x00 and the reseult of the or is also 0x00
-                      // this means, if there is any bit in c set to 0, then BCL is not unate and we can finish this procedure
-        if ( _mm_movemask_epi8(_mm_or_si128(o, z)) != 0x0ffff )
-          return 0;
-        
-        z = _mm_cmpeq_epi8(_mm_loadu_si128(zero_cnt_cube[1]+b), _mm_setzero_si128());     // 0 cnt becomes 0xff and all other values become 0x00
-        o = _mm_cmpeq_epi8(_mm_loadu_si128(one_cnt_cube[1]+b), _mm_setzero_si128());     // 0 cnt becomes 0xff and all other values become 0x00
-                       // if ones and zeros are present, then both values are 0x00 and the reseult of the or is also 0x00
-                      // this means, if there is any bit in c set to 0, then BCL is not unate and we can finish this procedure
-        if ( _mm_movemask_epi8(_mm_or_si128(o, z)) != 0x0ffff )
-          return 0;
-
-        z = _mm_cmpeq_epi8(_mm_loadu_si128(zero_cnt_cube[2]+b), _mm_setzero_si128());     // 0 cnt becomes 0xff and all other values become 0x00
-        o = _mm_cmpeq_epi8(_mm_loadu_si128(one_cnt_cube[2]+b), _mm_setzero_si128());     // 0 cnt becomes 0xff and all other values become 0x00
-                       // if ones and zeros are present, then both values are 0x00 and the reseult of the or is also 0x00
-                      // this means, if there is any bit in c set to 0, then BCL is not unate and we can finish this procedure
-        if ( _mm_movemask_epi8(_mm_or_si128(o, z)) != 0x0ffff )
-          return 0;
-
-        z = _mm_cmpeq_epi8(_mm_loadu_si128(zero_cnt_cube[3]+b), _mm_setzero_si128());     // 0 cnt becomes 0xff and all other values become 0x00
-        o = _mm_cmpeq_epi8(_mm_loadu_si128(one_cnt_cube[3]+b), _mm_setzero_si128());     // 0 cnt becomes 0xff and all other values become 0x00
-                       // if ones and zeros are present, then both values are 0x00 and the reseult of the or is also 0x00
-                      // this means, if there is any bit in c set to 0, then BCL is not unate and we can finish this procedure
-        if ( _mm_movemask_epi8(_mm_or_si128(o, z)) != 0x0ffff )
-          return 0;
-        
-        
-        
-
-        z = _mm_cmpeq_epi8(_mm_loadu_si128(zero_cnt_cube[4]+b), _mm_setzero_si128());     // 0 cnt becomes 0xff and all other values become 0x00
-        o = _mm_cmpeq_epi8(_mm_loadu_si128(one_cnt_cube[4]+b), _mm_setzero_si128());     // 0 cnt becomes 0xff and all other values become 0x00
-                       // if ones and zeros are present, then both values are 0x00 and the reseult of the or is also 0x00
-                      // this means, if there is any bit in c set to 0, then BCL is not unate and we can finish this procedure
-        if ( _mm_movemask_epi8(_mm_or_si128(o, z)) != 0x0ffff )
-          return 0;
-
-        z = _mm_cmpeq_epi8(_mm_loadu_si128(zero_cnt_cube[5]+b), _mm_setzero_si128());     // 0 cnt becomes 0xff and all other values become 0x00
-        o = _mm_cmpeq_epi8(_mm_loadu_si128(one_cnt_cube[5]+b), _mm_setzero_si128());     // 0 cnt becomes 0xff and all other values become 0x00
-                       // if ones and zeros are present, then both values are 0x00 and the reseult of the or is also 0x00
-                      // this means, if there is any bit in c set to 0, then BCL is not unate and we can finish this procedure
-        if ( _mm_movemask_epi8(_mm_or_si128(o, z)) != 0x0ffff )
-          return 0;
-
-        z = _mm_cmpeq_epi8(_mm_loadu_si128(zero_cnt_cube[6]+b), _mm_setzero_si128());     // 0 cnt becomes 0xff and all other values become 0x00
-        o = _mm_cmpeq_epi8(_mm_loadu_si128(one_cnt_cube[6]+b), _mm_setzero_si128());     // 0 cnt becomes 0xff and all other values become 0x00
-                       // if ones and zeros are present, then both values are 0x00 and the reseult of the or is also 0x00
-                      // this means, if there is any bit in c set to 0, then BCL is not unate and we can finish this procedure
-        if ( _mm_movemask_epi8(_mm_or_si128(o, z)) != 0x0ffff )
-          return 0;
-
-        z = _mm_cmpeq_epi8(_mm_loadu_si128(zero_cnt_cube[7]+b), _mm_setzero_si128());     // 0 cnt becomes 0xff and all other values become 0x00
-        o = _mm_cmpeq_epi8(_mm_loadu_si128(one_cnt_cube[7]+b), _mm_setzero_si128());     // 0 cnt becomes 0xff and all other values become 0x00
-                       // if ones and zeros are present, then both values are 0x00 and the reseult of the or is also 0x00
-                      // this means, if there is any bit in c set to 0, then BCL is not unate and we can finish this procedure
-        if ( _mm_movemask_epi8(_mm_or_si128(o, z)) != 0x0ffff )
+    z = _mm_setzero_si128();
+    o = _mm_setzero_si128();
+    for( j = 0; j < l->cnt; j++ )
+    {
+      if ( l->flags[j] == 0 )
+      {
+        c = _mm_loadu_si128(bcp_GetBCLCube(p, l, j)+b);
+        z = _mm_or_si128(z, _mm_andnot_si128(_mm_srli_epi16(c, 1), _mm_set1_epi8(0x55)));    // zero (01) or illegal
+        o = _mm_or_si128(o, _mm_andnot_si128(c, _mm_set1_epi8(0x55)));                          // one (10) or illegal
+        if ( _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_and_si128(z, o), _mm_setzero_si128())) != 0x0ffff )
           return 0;
-        
-        
+      }
+    }
   }
   return 1;
 }
-
@@ -117,7 +117,7 @@ void bcp_skip_space(bcp p, const char **s)
 #define BCP_IDENTIFIER_MAX 1024
 const char *bcp_get_identifier(bcp p, const char **s)
 {
-  static char identifier[BCP_IDENTIFIER_MAX];
+  static __thread char identifier[BCP_IDENTIFIER_MAX];   // thread local, one parser per thread is allowed
   int i = 0;
   identifier[0] = '\0';
   //if ( isalpha(**s) || **s == '_' )
@@ -172,7 +172,7 @@ int bcp_get_value(bcp p, const char **s)
 
 bcx bcp_ParseAtom(bcp p, const char **s)
 {
-  static char msg[32];
+  char msg[32];
   bcx x;
 
   if ( **s == '\0' || **s == p->x_end )    // this is reached if the string is full empty
@@ -628,6 +628,70 @@ bcl bcp_NewBCLById(bcp p, int is_not, const char *identifier)
   return NULL; // error
 }
 
+/*
+  intersection of the lists for "x" and all following elements (x->next) of an AND node.
+  The lists are intersected in the order of their size, starting with the smallest
+  lists: this keeps the intermediate result small for an AND of ORs.
+  The intersection stops, if the intermediate result is empty.
+  returns NULL for memory error
+*/
+static bcl bcp_NewBCLByBCXAnd(bcp p, bcx x)
+{
+  int i, j, cnt = 0;
+  int is_ok;
+  bcx y;
+  bcl *list;
+  bcl l, t;
+  
+  if ( x == NULL )
+    return bcp_NewBCL(p);
+  for( y = x; y != NULL; y = y->next )
+    cnt++;
+  list = (bcl *)malloc(cnt*sizeof(bcl));
+  if ( list == NULL )
+    return NULL;
+  for( i = 0; x != NULL; x = x->next )
+  {
+    l = bcp_NewBCLByBCX(p, x);
+    if ( l == NULL )
+    {
+      while( i > 0 )
+        bcp_DeleteBCL(p, list[--i]);
+      return free(list), NULL;
+    }
+    list[i++] = l;
+    if ( l->cnt == 0 )
+      break;            // the intersection with an empty list is empty
+  }
+  cnt = i;
+  
+  /* stable sort by the number of cubes */
+  for( i = 1; i < cnt; i++ )
+  {
+    l = list[i];
+    for( j = i; j > 0 && list[j-1]->cnt > l->cnt; j-- )
+      list[j] = list[j-1];
+    list[j] = l;
+  }
+  
+  t = bcp_NewBCL(p);
+  for( i = 1; i < cnt && t != NULL && list[0]->cnt > 0; i++ )
+  {
+    if ( bcp_IntersectionBCLs(p, t, list[0], list[i]) == 0 )  // bclintersection.c
+      break;            // memory error or budget exceeded
+    l = list[0];        // exchange list[0] and "t", "t" is cleared by the next intersection
+    list[0] = t;
+    t = l;
+  }
+  is_ok = t != NULL && (i >= cnt || list[0]->cnt == 0);
+  l = is_ok ? list[0] : NULL;         // NULL: memory error or budget exceeded, all lists are deleted
+  bcp_DeleteBCL(p, t);
+  for( i = is_ok ? 1 : 0; i < cnt; i++ )
+    bcp_DeleteBCL(p, list[i]);
+  free(list);
+  return l;
+}
+
 bcl bcp_NewBCLByBCX(bcp p, bcx x)
 {
   bcl l;
@@ -649,29 +713,8 @@ bcl bcp_NewBCLByBCX(bcp p, bcx x)
           return bcp_NewBCL(p); // empty list
       return bcp_NewBCLWithCube(p, 3);  // tautology list
     case BCX_TYPE_AND:
-      //bcp_ShowBCX(p, x);
-      //puts(" AND");
-      x = x->down;
-      l = bcp_NewBCLByBCX(p, x);
-      //bcp_ShowBCX(p, x);
-      //puts(" AND");
-      //bcp_ShowBCL(p, l);
-    
-      x = x->next;
-      while( x != NULL )
-      {
-        bcl ll = bcp_NewBCLByBCX(p, x);
-        assert( ll != NULL );
-        //bcp_ShowBCX(p, x);
-        //puts(" AND");
-        //bcp_ShowBCL(p, ll);
-        
-        bcp_IntersectionBCL(p, l, ll);  // bclintersection.c
-        //puts("-->");
-        //bcp_ShowBCL(p, l);
-        bcp_DeleteBCL(p, ll);
-        x = x->next;
-      }
+      l = bcp_NewBCLByBCXAnd(p, x->down);
+      assert( l != NULL );
       if ( is_not )
       {
         bcl ll = bcp_NewBCLComplement(p, l);
@@ -0,0 +1,87 @@
+/*
+
+  bcgovernor.c
+
+  resource governor: limits for the wall clock time, the number of recursion
+  nodes and the size of the cube lists
+
+  Boolean Cube Calculator
+  (c) 2024 Oliver Kraus
+  https://github.com/olikraus/boolean_cube
+
+  License: CC BY-SA Attribution-ShareAlike 4.0 International
+  https://creativecommons.org/licenses/by-sa/4.0/
+
+
+  Recursive procedures (tautology, complement) call bcp_CheckGovernor() for
+  each node, loops (subtract, intersection, expand, multi cube containment)
+  call bcp_CheckGovernor() once per step. bcp_ExtendBCL() will not extend a
+  list beyond the cube limit.
+
+  If one of the limits is reached, then all further checks fail until the
+  governor is started again. The procedures return a conservative result:
+    - tautology: 0, a cube is not covered, so it is neither removed nor expanded
+    - expand, multi cube containment: stop, the list is still a valid cover
+    - subtract, intersection, complement: 0 or NULL (error)
+  Use bcp_IsGovernorExceeded() to distinguish this from a memory error.
+
+*/
+
+#include "bc.h"
+#include <time.h>
+
+/*
+  monotonic wall clock in CLOCKS_PER_SEC units.
+  clock() returns the cpu time of the process, which is the sum for all threads.
+*/
+clock_t bcp_GetMonotonicClock(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (clock_t)ts.tv_sec*CLOCKS_PER_SEC + (clock_t)(ts.tv_nsec/(1000000000L/CLOCKS_PER_SEC));
+}
+
+/* restart the governor with the current limits */
+void bcp_StartGovernor(bcp p)
+{
+  p->gov.start = bcp_GetMonotonicClock();
+  p->gov.node_cnt = 0;
+  p->gov.is_exceeded = 0;
+  p->gov.is_active = p->gov.time_limit > 0 || p->gov.node_limit > 0 || p->gov.cube_limit > 0;
+}
+
+/*
+  time_limit: max wall clock time in seconds
+  node_limit: max number of recursion nodes and loop steps
+  cube_limit: max number of cubes in a single list
+  0 disables the corresponding limit. The governor is started with the new limits.
+*/
+void bcp_SetGovernor(bcp p, double time_limit, long node_limit, int cube_limit)
+{
+  p->gov.time_limit = (clock_t)(time_limit*CLOCKS_PER_SEC);
+  p->gov.node_limit = node_limit;
+  p->gov.cube_limit = cube_limit;
+  bcp_StartGovernor(p);
+}
+
+/* mark the budget as exceeded, always returns 0 */
+int bcp_SetGovernorExceeded(bcp p, const char *limit_name)
+{
+  if ( p->gov.is_exceeded == 0 )
+    logprint(1, "resource governor: %s limit exceeded after %ld nodes", limit_name, p->gov.node_cnt);
+  p->gov.is_exceeded = 1;
+  return 0;
+}
+
+/* count one node, returns 0 if the budget is exceeded, use bcp_CheckGovernor() instead */
+int bcp_CountGovernorNode(bcp p)
+{
+  if ( p->gov.is_exceeded )
+    return 0;
+  p->gov.node_cnt++;
+  if ( p->gov.node_limit > 0 && p->gov.node_cnt > p->gov.node_limit )
+    return bcp_SetGovernorExceeded(p, "node");
+  if ( p->gov.time_limit > 0 && bcp_GetMonotonicClock() - p->gov.start > p->gov.time_limit )
+    return bcp_SetGovernorExceeded(p, "time");
+  return 1;
+}
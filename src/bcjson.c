@@ -57,6 +57,11 @@
 
     minimize
         { "cmd":"minimize", "slot":<int> }
+      with "mode":"espresso" the ESPRESSO loop is used and the cost of each iteration is reported as "espressoStats"
+      (not for a result from the result cache)
+        { "cmd":"minimize", "slot":<int>, "mode":"espresso" }
+      with "mode":"exact" the number of cubes is minimal, if "exact" is 1 in the output
+        { "cmd":"minimize", "slot":<int>, "mode":"exact", "timeLimit":<sec> }
     
     complement
         { "cmd":"complement", "slot":<int> }
@@ -77,6 +82,11 @@
       if slot is present, then calculate intersection between slot 0 and the provided slot
         { "cmd":"intersection0", "slot":1 }
     
+    intersection0empty
+      Same as intersection0, but only the "empty" flag is calculated, slot 0 is not modified.
+      The calculation stops with the first cube of the intersection.
+        { "cmd":"intersection0empty", "slot":1 }
+    
     union0
       Calculate union and store the result in slot 0
     
@@ -125,7 +135,7 @@
 */
 co bc_ExecuteVector(cco in)
 {
-  static char err[1024];
+  char err[1024];     // not static: bc_ExecuteVector may run in parallel threads (bcc -batch)
   // struct tms start, end;
   clock_t start, bstart, end;
   bcp p = NULL;
@@ -146,6 +156,15 @@ co bc_ExecuteVector(cco in)
   int is_0_superset = -1;
   int is_0_subset = -1;
   int is_out_arg = 0;
+  int is_budget_exceeded = 0;
+  double time_limit = 0.0;
+  long node_limit = 0;
+  int cube_limit = 0;
+  int subtract_order = BCP_SUBTRACT_ORDER_LIST;
+  int is_subtract_stat = 0;
+  int spill_cnt = 0;
+  const char *spill_dir = NULL;
+  int minimize_mode = BCP_MINIMIZE_MODE_DEFAULT;
   co debugMap = NULL;
   co output = coNewMap(CO_STRDUP|CO_STRFREE|CO_FREE_VALS);
   
@@ -281,7 +300,18 @@ co bc_ExecuteVector(cco in)
     slot = 0;
     is_empty = -1;
     is_out_arg = 0;
+    is_budget_exceeded = 0;
+    time_limit = 0.0;
+    node_limit = 0;
+    cube_limit = 0;
+    subtract_order = BCP_SUBTRACT_ORDER_LIST;
+    is_subtract_stat = 0;
+    spill_cnt = 0;
+    spill_dir = NULL;
+    minimize_mode = BCP_MINIMIZE_MODE_DEFAULT;
     err[0] = '\0';
+    if ( p != NULL )
+      bcp_SetGovernor(p, 0.0, 0, 0);        // no limits for the parser
     if ( l != NULL )
       bcp_DeleteBCL(p, l);
     l = NULL;
@@ -309,6 +339,52 @@ co bc_ExecuteVector(cco in)
 
 
 
+      o = coMapGet(cmdmap, "timeLimit");        // resource limits for this cmd, see bcgovernor.c
+      if (coIsDbl(o))
+        time_limit = coDblGet(o);
+
+      o = coMapGet(cmdmap, "nodeLimit");
+      if (coIsDbl(o))
+        node_limit = (long)coDblGet(o);
+
+      o = coMapGet(cmdmap, "cubeLimit");
+      if (coIsDbl(o))
+        cube_limit = (int)coDblGet(o);
+
+      o = coMapGet(cmdmap, "subtractOrder");    // order of the subtrahend cubes, see bclsubtract.c
+      if (coIsStr(o))
+      {
+        subtract_order = bcp_GetSubtractOrderByName(coStrGet(o));
+        if ( subtract_order < 0 )
+        {
+          sprintf(err, "Unknown subtractOrder '%.64s'", coStrGet(o));
+          subtract_order = BCP_SUBTRACT_ORDER_LIST;
+        }
+      }
+
+      o = coMapGet(cmdmap, "subtractStats");
+      if ( o != NULL )
+        is_subtract_stat = 1;
+
+      o = coMapGet(cmdmap, "spillCubes");       // out of core storage for large lists, see bclspill.c
+      if (coIsDbl(o))
+        spill_cnt = (int)coDblGet(o);
+
+      o = coMapGet(cmdmap, "spillDir");
+      if (coIsStr(o))
+        spill_dir = coStrGet(o);
+
+      o = coMapGet(cmdmap, "mode");     // algorithm of the minimization, see bclespresso.c
+      if (coIsStr(o))
+      {
+        minimize_mode = bcp_GetMinimizeModeByName(coStrGet(o));
+        if ( minimize_mode < 0 )
+        {
+          sprintf(err, "Unknown mode '%.64s'", coStrGet(o));
+          minimize_mode = BCP_MINIMIZE_MODE_DEFAULT;
+        }
+      }
+
       o = coMapGet(cmdmap, "slot");
       if (coIsDbl(o))
       {
@@ -405,6 +481,18 @@ co bc_ExecuteVector(cco in)
       arg = (l!=NULL)?l:slot_list[slot];               // arg is taken from "bcl", "expr", "mtvar" or a given slot.  Slot 0 is used if nothing is provided 
       
       logprint(1, "json cmd %d/%d '%s'", i+1, cnt, cmd);
+      if ( p != NULL )
+      {
+        bcp_SetGovernor(p, time_limit, node_limit, cube_limit);
+        p->subtract_order = subtract_order;
+        p->subtract_stat.is_record = is_subtract_stat;
+        p->spill_cnt = spill_cnt;
+        p->spill_dir = (char *)spill_dir;
+        p->subtract_stat.step_cnt = -1;         // no subtract in this cmd
+        p->minimize_mode = minimize_mode;
+        p->espresso_stat.iteration_cnt = -1;    // no minimize in this cmd
+        p->is_minimize_exact = -1;
+      }
 
       // "bcl2slot"  "bcl" into "slot"
       if ( p != NULL && strcmp(cmd, "bcl2slot") == 0 )
@@ -504,6 +592,15 @@ co bc_ExecuteVector(cco in)
         if ( slot_list[0]->cnt == 0 )
           is_empty = 1;
       }
+      // intersection0empty: only check, whether the intersection with slot 0 is empty
+      // slot 0 is not modified
+      else if ( p != NULL &&  strcmp(cmd, "intersection0empty") == 0 )
+      {
+        assert(slot_list[0] != NULL);
+        assert(arg != NULL);
+        is_empty = bcp_IsBCLIntersectionEmpty(p, slot_list[0], arg);      // bclintersection.c
+        assert(is_empty >= 0 || bcp_IsGovernorExceeded(p));
+      }
       // intersection0: calculate intersection with slot 0
       // result is stored in slot 0
       else if ( p != NULL &&  strcmp(cmd, "intersection0") == 0 )
@@ -538,7 +635,7 @@ co bc_ExecuteVector(cco in)
         {
             coMapAdd(debugMap, "out_result", coNewStr(CO_STRFREE, bcp_GetExpressionBCL(p, slot_list[0])));
         }
-        assert(intersection_result != 0);
+        assert(intersection_result != 0 || bcp_IsGovernorExceeded(p));
         bcp_DoBCLXGroup(p, slot_list[0]);
         is_empty = 0;
         if ( slot_list[0]->cnt == 0 )
@@ -565,7 +662,7 @@ co bc_ExecuteVector(cco in)
         assert(arg != NULL);
         subtract_result = bcp_SubtractBCL(p, slot_list[0], arg, 1);   // a = a minus b 
         bcp_DoBCLXGroup(p, slot_list[0]);
-        assert(subtract_result != 0);
+        assert(subtract_result != 0 || bcp_IsGovernorExceeded(p));
         is_empty = 0;
         if ( slot_list[0]->cnt == 0 )
           is_empty = 1;
@@ -623,6 +720,13 @@ co bc_ExecuteVector(cco in)
 
       // STEP 3: Generate JSON output
 
+      if ( p != NULL && bcp_IsGovernorExceeded(p) )
+      {
+        is_budget_exceeded = 1;
+        if ( err[0] == '\0' )
+          sprintf(err, "Budget exceeded in cmd '%s'", cmd);
+      }
+
       if ( err[0] != '\0' )
       {
         co e = coNewMap(CO_STRDUP|CO_STRFREE|CO_FREE_VALS);
@@ -654,6 +758,49 @@ co bc_ExecuteVector(cco in)
           coMapAdd(e, "subset", coNewDbl(is_0_subset));          
         }
 
+        if ( is_budget_exceeded )
+        {
+          coMapAdd(e, "budgetExceeded", coNewDbl(1));          
+        }
+
+        if ( is_subtract_stat && p != NULL && p->subtract_stat.step_cnt >= 0 )
+        {
+          int j;
+          co st = coNewMap(CO_STRDUP|CO_STRFREE|CO_FREE_VALS);
+          co sv = coNewVector(CO_FREE_VALS);
+          co tv = coNewVector(CO_FREE_VALS);
+          for( j = 0; j < p->subtract_stat.step_cnt; j++ )
+          {
+            coVectorAdd(sv, coNewDbl(p->subtract_stat.size_list[j]));
+            coVectorAdd(tv, coNewDbl((double)p->subtract_stat.clock_list[j]/CLOCKS_PER_SEC));
+          }
+          coMapAdd(st, "steps", coNewDbl(p->subtract_stat.step_cnt));
+          coMapAdd(st, "peak", coNewDbl(p->subtract_stat.peak_cnt));
+          coMapAdd(st, "time", coNewDbl((double)p->subtract_stat.total_clock/CLOCKS_PER_SEC));
+          coMapAdd(st, "stepSize", sv);
+          coMapAdd(st, "stepTime", tv);
+          coMapAdd(e, "subtractStats", st);
+        }
+
+        if ( minimize_mode == BCP_MINIMIZE_MODE_EXACT && p != NULL && p->is_minimize_exact >= 0 )
+        {
+          coMapAdd(e, "exact", coNewDbl(p->is_minimize_exact));
+        }
+
+        if ( minimize_mode == BCP_MINIMIZE_MODE_ESPRESSO && p != NULL && p->espresso_stat.iteration_cnt >= 0 )
+        {
+          int j;
+          co ev = coNewVector(CO_FREE_VALS);
+          for( j = 0; j < p->espresso_stat.iteration_cnt; j++ )
+          {
+            co it = coNewMap(CO_STRDUP|CO_STRFREE|CO_FREE_VALS);
+            coMapAdd(it, "cubes", coNewDbl(p->espresso_stat.cube_cnt_list[j]));
+            coMapAdd(it, "literals", coNewDbl(p->espresso_stat.literal_cnt_list[j]));
+            coVectorAdd(ev, it);
+          }
+          coMapAdd(e, "espressoStats", ev);
+        }
+
         end = clock();
         coMapAdd(e, "time", coNewDbl((double)(end-bstart)/CLOCKS_PER_SEC));
         
@@ -715,6 +862,11 @@ co bc_ExecuteVector(cco in)
     {
       coMapAdd(e, "vmap", coClone(p->var_map));   // memory leak !!!
       coMapAdd(e, "vlist", coClone(p->var_list));
+      coMapAdd(e, "tautCacheHit", coNewDbl(p->taut_cache_hit_cnt));
+      coMapAdd(e, "tautCacheMiss", coNewDbl(p->taut_cache_miss_cnt));
+      coMapAdd(e, "coverCexHit", coNewDbl(p->cover_cex_hit_cnt));
+      coMapAdd(e, "resultCacheHit", coNewDbl(p->result_cache_hit_cnt));
+      coMapAdd(e, "resultCacheMiss", coNewDbl(p->result_cache_miss_cnt));
     }
     //coMapAdd(e, "time", coNewDbl((double)(end.tms_utime-start.tms_utime)));
     coMapAdd(e, "time", coNewDbl((double)(end-start)/CLOCKS_PER_SEC));
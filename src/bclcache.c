@@ -0,0 +1,144 @@
+/*
+
+  bclcache.c
+
+  boolean cube list: result cache for complement, minimize, xgroup and subset
+
+  Boolean Cube Calculator
+  (c) 2024 Oliver Kraus
+  https://github.com/olikraus/boolean_cube
+
+  License: CC BY-SA Attribution-ShareAlike 4.0 International
+  https://creativecommons.org/licenses/by-sa/4.0/
+
+
+  A JSON vector often calculates the same complement or minimization more
+  than once (e.g. after copying a slot). The results of these operations are
+  stored in a small cache, which is part of the bcp structure.
+
+  The key is the operation, the fingerprint of the argument (see
+  bcp_GetBCLFingerprint() in bcltautology.c) and the fingerprint of a second
+  list: the second argument for the subset test and p->exclude_group_list for
+  the xgroup operation.
+
+  The cached result list is shared: bcp_FindResultCache() returns the entry
+  and the caller has to copy the list before modifying it. The cache keeps its
+  own copy of each result, so a later modification of the caller's list does
+  not change the cache.
+
+  Results, which were calculated after the resource governor was exceeded
+  (see bcgovernor.c), are not stored.
+
+*/
+
+#include "bc.h"
+#include <stdlib.h>
+#include <string.h>
+
+/* remove all entries from the cache */
+void bcp_ClearResultCache(bcp p)
+{
+  int i;
+  if ( p->result_cache == NULL )
+    return;
+  for( i = 0; i < p->result_cache_alloc_size; i++ )
+    bcp_DeleteBCL(p, p->result_cache[i].result);
+  free(p->result_cache);
+  p->result_cache = NULL;
+  p->result_cache_alloc_size = 0;
+  p->result_cache_pos = 0;
+}
+
+/*
+  calculate the key for the operation "op" with the argument "a" and the second list "b" (can be NULL)
+  returns 0 if the cache is disabled or "a" is too small
+*/
+int bcp_GetResultCacheKey(bcp p, struct bcp_result_cache_struct *key, int op, bcl a, bcl b)
+{
+  memset(key, 0, sizeof(struct bcp_result_cache_struct));
+  if ( p->result_cache_size <= 0 )
+    return 0;
+  key->op = op;
+  key->cnt = bcp_GetBCLFingerprint(p, a, &(key->fp1), &(key->fp2));
+  if ( key->cnt < p->result_cache_min_cnt )
+    return 0;
+  if ( b != NULL )
+    key->arg_cnt = bcp_GetBCLFingerprint(p, b, &(key->arg_fp1), &(key->arg_fp2));
+  return 1;
+}
+
+/* returns the entry for the key or NULL, if the result is not in the cache */
+struct bcp_result_cache_struct *bcp_FindResultCache(bcp p, struct bcp_result_cache_struct *key)
+{
+  int i;
+  struct bcp_result_cache_struct *e;
+  if ( p->result_cache != NULL )
+  {
+    for( i = 0; i < p->result_cache_alloc_size; i++ )
+    {
+      e = p->result_cache + i;
+      if ( e->op == key->op && e->fp1 == key->fp1 && e->fp2 == key->fp2 && e->cnt == key->cnt
+        && e->arg_fp1 == key->arg_fp1 && e->arg_fp2 == key->arg_fp2 && e->arg_cnt == key->arg_cnt )
+      {
+        p->result_cache_hit_cnt++;
+        return e;
+      }
+    }
+  }
+  p->result_cache_miss_cnt++;
+  return NULL;
+}
+
+/* returns a free entry, an old entry is replaced if the cache is full, returns NULL for memory error */
+static struct bcp_result_cache_struct *bcp_new_result_cache_entry(bcp p, struct bcp_result_cache_struct *key)
+{
+  struct bcp_result_cache_struct *e;
+  if ( p->result_cache != NULL && p->result_cache_alloc_size != p->result_cache_size )
+    bcp_ClearResultCache(p);    // p->result_cache_size has been changed
+  if ( p->result_cache == NULL )
+  {
+    p->result_cache = (struct bcp_result_cache_struct *)calloc(p->result_cache_size, sizeof(struct bcp_result_cache_struct));
+    if ( p->result_cache == NULL )
+      return NULL;
+    p->result_cache_alloc_size = p->result_cache_size;
+    p->result_cache_pos = 0;
+  }
+  e = p->result_cache + p->result_cache_pos;
+  p->result_cache_pos = (p->result_cache_pos + 1) % p->result_cache_alloc_size;
+  bcp_DeleteBCL(p, e->result);
+  *e = *key;
+  e->result = NULL;
+  e->value = 0;
+  return e;
+}
+
+/* store a copy of "result" for the key, returns 0 for memory error */
+int bcp_AddResultCacheBCL(bcp p, struct bcp_result_cache_struct *key, bcl result)
+{
+  struct bcp_result_cache_struct *e;
+  bcl l;
+  if ( bcp_IsGovernorExceeded(p) )
+    return 1;           // the result might be incomplete
+  l = bcp_NewBCLByBCL(p, result);
+  if ( l == NULL )
+    return 0;
+  bcp_PurgeBCL(p, l);
+  e = bcp_new_result_cache_entry(p, key);
+  if ( e == NULL )
+    return bcp_DeleteBCL(p, l), 0;
+  e->result = l;
+  return 1;
+}
+
+/* store "value" for the key, returns 0 for memory error */
+int bcp_AddResultCacheValue(bcp p, struct bcp_result_cache_struct *key, int value)
+{
+  struct bcp_result_cache_struct *e;
+  if ( bcp_IsGovernorExceeded(p) )
+    return 1;           // the result might be incomplete
+  e = bcp_new_result_cache_entry(p, key);
+  if ( e == NULL )
+    return 0;
+  e->value = value;
+  return 1;
+}
@@ -43,58 +43,256 @@ int bcp_IsBCLCubeSingleCovered(bcp p, bcl l, bc c)
 */
 void bcp_DoBCLSingleCubeContainment(bcp p, bcl l)
 {
-  int i, j;
+  int i, j, k, m;
   int cnt = l->cnt;
+  int sort_cnt = 0;
+  int vc_max = p->blk_cnt*p->vars_per_blk_cnt*2;
   bc c;
-  int vc;
+  uint64_t sig;
   int reduceCnt = 0;
+  int *vcl;
+  int *pos_list;                // cube positions, sorted by the number of literals
+  int *group_list;              // start of each group in pos_list
+  uint64_t *sig_list;           // literal signature for each entry of pos_list
+  bci x;
+  bcp_InvalidateBCLVarCnt(p, l);        // flags are modified directly
   
   /*
     calculate the number of 01 and 10 codes for each of the cubes in "l"
     idea is to reduce the number of "subset" tests, because for a cube with n variables,
     can be a subset of another cube only if this other cube has lesser variables.
     however: also the equal case is checked, this means to check whether two cubes are identical
+    
+    The cubes are sorted by this number (counting sort, the order of the cubes with the same 
+    number is kept), so each cube is only compared with the following cubes: A cube with the 
+    same number can only be a subset if both cubes are identical, in which case the later cube
+    is removed.
+    Most of the remaining pairs are rejected by the 64 bit literal signature.
   */
-  int *vcl = bcp_GetBCLVarCntList(p, l);
-
+  vcl = bcp_GetBCLVarCntList(p, l);
+  pos_list = (int *)malloc(cnt*sizeof(int)+1);
+  group_list = (int *)calloc(vc_max+2, sizeof(int));
+  sig_list = (uint64_t *)malloc(cnt*sizeof(uint64_t)+1);
+  if ( vcl == NULL || pos_list == NULL || group_list == NULL || sig_list == NULL )
+  {
+    free(vcl); free(pos_list); free(group_list); free(sig_list);
+    logprint(1, "bcp_DoBCLSingleCubeContainment: memory error");
+    return;
+  }
   
   for( i = 0; i < cnt; i++ )
+    if ( vcl[i] >= 0 )
+      group_list[vcl[i]+1]++;
+  for( k = 1; k <= vc_max+1; k++ )
+    group_list[k] += group_list[k-1];
+  for( i = 0; i < cnt; i++ )
+  {
+    if ( vcl[i] >= 0 )
+    {
+      k = group_list[vcl[i]]++;
+      pos_list[k] = i;
+      sig_list[k] = bcp_GetCubeLiteralSignature(p, bcp_GetBCLCube(p, l, i));
+      sort_cnt++;
+    }
+  }
+  
+  /*
+    for larger lists, the candidates for the subset test are taken from the inverted literal index:
+    only the cubes, which have the rarest literal of "c", are checked
+  */
+  x = NULL;
+  if ( sort_cnt >= BCP_SCC_INDEX_MIN_CNT )
+    x = bcp_NewBCI(p, l);
+  if ( x != NULL )
+  {
+    for( k = 0; k < sort_cnt; k++ )
+    {
+      i = pos_list[k];
+      if ( l->flags[i] == 0 )
+        reduceCnt += bcp_DoBCISubsetCubeMark(p, x, l, bcp_GetBCLCube(p, l, i), i);
+    }
+    bcp_DeleteBCI(p, x);
+    sort_cnt = 0;       // skip the loop below
+  }
+  
+  for( k = 0; k < sort_cnt; k++ )
   {
+    i = pos_list[k];
     if ( l->flags[i] == 0 )
     {
       c = bcp_GetBCLCube(p, l, i);
-      vc = vcl[i];
-      for( j = 0; j < cnt; j++ )
+      sig = sig_list[k];
+      for( m = k+1; m < sort_cnt; m++ )
       {
+        if ( (sig & ~sig_list[m]) != 0 )
+          continue;     // some literal of "c" is missing in the other cube
+        j = pos_list[m];
         if ( l->flags[j] == 0 )
         {
-          if ( i != j )
+          /*
+            test, whether "b" is a subset of "a"
+            returns:      
+              1: yes, "b" is a subset of "a"
+              0: no, "b" is not a subset of "a"
+          */
+          if ( bcp_IsSubsetCube(p, c, bcp_GetBCLCube(p, l, j)) != 0 )       // bcube.c:bcp_IsSubsetCube
           {
-            /*
-              test, whether "b" is a subset of "a"
-              returns:      
-                1: yes, "b" is a subset of "a"
-                0: no, "b" is not a subset of "a"
-              A mandatory condition for this is, that b has more variables than a
-            */
-            if ( vcl[j] >= vc )
-            {
-              if ( bcp_IsSubsetCube(p, c, bcp_GetBCLCube(p, l, j)) != 0 )       // bcube.c:bcp_IsSubsetCube
-              {
-                l->flags[j] = 1;      // mark the j cube as deleted
-		reduceCnt++;
-              }
-            }
-          } // j != i
+            l->flags[j] = 1;      // mark the j cube as deleted
+            reduceCnt++;
+          }
         } // j cube not deleted
-      } // j loop
+      } // m loop
     } // i cube not deleted
-  } // i loop
+  } // k loop
   bcp_PurgeBCL(p, l);
+  free(sig_list);
+  free(group_list);
+  free(pos_list);
   free(vcl);
   logprint(8, "bcp_DoBCLSingleCubeContainment, reduceCnt=%d, bcl size=%d", reduceCnt, l->cnt);  
 }
 
+/*============================================================*/
+/* counterexample cache for the cover test */
+
+/*
+  The last minterms, which were not covered in a cover test, are kept in p->cover_cex_list.
+  A new cover test is answered without the tautology test, if one of these minterms is inside 
+  the cube and outside of the list.
+  Layout of p->cover_cex_list: p->cover_cex_size entries for the minterms, flag 1 marks an 
+  unused entry, followed by one entry for the minterm of the tautology test.
+*/
+static int bcp_prepare_cover_cex(bcp p)
+{
+  int i;
+  if ( p->cover_cex_list != NULL )
+  {
+    if ( p->cover_cex_list->cnt == p->cover_cex_size+1 )
+      return 1;
+    bcp_DeleteBCL(p, p->cover_cex_list);        // p->cover_cex_size has been changed
+  }
+  p->cover_cex_list = bcp_NewBCL(p);
+  if ( p->cover_cex_list == NULL )
+    return 0;
+  for( i = 0; i <= p->cover_cex_size; i++ )
+  {
+    if ( bcp_AddBCLCube(p, p->cover_cex_list) < 0 )
+      return bcp_DeleteBCL(p, p->cover_cex_list), p->cover_cex_list = NULL, 0;
+    p->cover_cex_list->flags[i] = 1;
+  }
+  p->cover_cex_pos = 0;
+  return 1;
+}
+
+void bcp_ClearCoverCounterexampleCache(bcp p)
+{
+  bcp_DeleteBCL(p, p->cover_cex_list);
+  p->cover_cex_list = NULL;
+  p->cover_cex_pos = 0;
+}
+
+/* returns 1 if the minterm "m" is not part of any cube of "l", the cube at position "exclude" is ignored */
+static int bcp_is_minterm_outside_bcl(bcp p, bcl l, bc m, int exclude)
+{
+  int i;
+  for( i = 0; i < l->cnt; i++ )
+    if ( l->flags[i] == 0 && i != exclude )
+      if ( bcp_IsSubsetCube(p, bcp_GetBCLCube(p, l, i), m) )
+        return 0;
+  return 1;
+}
+
+/* returns 1 if one of the cached minterms proves, that "c" is not covered by "l" */
+static int bcp_find_cover_cex(bcp p, bcl l, bc c, int exclude)
+{
+  int i;
+  bc m;
+  for( i = 0; i < p->cover_cex_size; i++ )
+  {
+    if ( p->cover_cex_list->flags[i] == 0 )
+    {
+      m = bcp_GetBCLCube(p, p->cover_cex_list, i);
+      if ( bcp_IsSubsetCube(p, c, m) && bcp_is_minterm_outside_bcl(p, l, m, exclude) )
+      {
+        p->cover_cex_hit_cnt++;
+        return 1;
+      }
+    }
+  }
+  return 0;
+}
+
+/* 
+  the minterm of the tautology test belongs to the cofactor: assign the literals of "c" 
+  to the minterm and store it in the cache
+*/
+static void bcp_add_cover_cex(bcp p, bc c)
+{
+  int i;
+  __m128i cc, dc;
+  bc m = bcp_GetBCLCube(p, p->cover_cex_list, p->cover_cex_size);
+  bc n = bcp_GetBCLCube(p, p->cover_cex_list, p->cover_cex_pos);
+  for( i = 0; i < p->blk_cnt; i++ )
+  {
+    cc = _mm_loadu_si128(c+i);
+    dc = _mm_and_si128(_mm_and_si128(cc, _mm_srli_epi16(cc, 1)), _mm_set1_epi8(0x55));
+    dc = _mm_or_si128(dc, _mm_slli_epi16(dc, 1));       // 11 for all don't care variables of "c"
+    _mm_storeu_si128(n+i, _mm_or_si128(_mm_and_si128(dc, _mm_loadu_si128(m+i)), _mm_andnot_si128(dc, cc)));
+  }
+  p->cover_cex_list->flags[p->cover_cex_pos] = 0;
+  p->cover_cex_pos++;
+  if ( p->cover_cex_pos >= p->cover_cex_size )
+    p->cover_cex_pos = 0;
+}
+
+/*
+  returns 1 if one of the cached counterexamples proves, that "c" is not covered by "l".
+  returns 0 if this is unknown, use bcp_IsBCLCubeCovered() in this case
+*/
+int bcp_IsBCLCubeRefutedByCache(bcp p, bcl l, bc c)
+{
+  if ( p->cover_cex_list == NULL || p->cover_cex_list->cnt != p->cover_cex_size+1 )
+    return 0;
+  return bcp_find_cover_cex(p, l, c, -1);
+}
+
+static int bcp_is_bcl_cube_covered(bcp p, bcl l, bc c, int exclude)
+{
+  bcl n;
+  int result;
+  
+  if ( bcp_IsIllegal(p, c) )
+  {
+    n = bcp_NewBCLCofactorByCube(p, l, c, exclude);
+    result = bcp_IsBCLTautology(p, n);
+    bcp_DeleteBCL(p, n);
+    return result;
+  }
+  
+  if ( p->cover_cex_size > 0 && bcp_prepare_cover_cex(p) != 0 )
+  {
+    if ( bcp_find_cover_cex(p, l, c, exclude) )
+      return 0;
+    n = bcp_NewBCLIntersectingCofactorByCube(p, l, c, exclude);
+    if ( n == NULL )
+      return 0;
+    result = bcp_IsBCLTautologyWithMinterm(p, n, bcp_GetBCLCube(p, p->cover_cex_list, p->cover_cex_size));
+    if ( result < 0 )
+      result = bcp_IsBCLTautology(p, n);
+    else if ( result == 0 )
+      bcp_add_cover_cex(p, c);
+    bcp_DeleteBCL(p, n);
+    return result;
+  }
+  
+  n = bcp_NewBCLIntersectingCofactorByCube(p, l, c, exclude);
+  if ( n == NULL )
+    return 0;
+  result = bcp_IsBCLTautology(p, n);
+  bcp_DeleteBCL(p, n);
+  return result;
+}
+
 /*============================================================*/
 /* complex cover, based on the idea, that the a cube is covered by a list, */
 /* if the cofactor of the list against that cube has the tautology property */
@@ -106,11 +304,7 @@ void bcp_DoBCLSingleCubeContainment(bcp p, bcl l)
 */
 int bcp_IsBCLCubeCovered(bcp p, bcl l, bc c)
 {
-  bcl n = bcp_NewBCLCofactorByCube(p, l, c, -1); /* (p) problem context, (l) cover list, (c) cube under test, (-1) exclude no cube */
-  int result = bcp_IsBCLTautology(p, n);
-
-  bcp_DeleteBCL(p, n);
-  return result;
+  return bcp_is_bcl_cube_covered(p, l, c, -1);  /* (p) problem context, (l) cover list, (c) cube under test, (-1) exclude no cube */
 }
 
 /*
@@ -118,10 +312,7 @@ int bcp_IsBCLCubeCovered(bcp p, bcl l, bc c)
 */
 int bcp_IsBCLCubeRedundant(bcp p, bcl l, int pos)
 {
-  bcl n = bcp_NewBCLCofactorByCube(p, l, bcp_GetBCLCube(p, l, pos), pos);
-  int result = bcp_IsBCLTautology(p, n);
-  bcp_DeleteBCL(p, n);
-  return result;
+  return bcp_is_bcl_cube_covered(p, l, bcp_GetBCLCube(p, l, pos), pos);
 }
 
 /*
@@ -130,7 +321,8 @@ int bcp_IsBCLCubeRedundant(bcp p, bcl l, int pos)
 
   Remove cubes from "l", whch are covered by the rest of the list "l".
 
-  This procedure will remove the smallest cubes first
+  This procedure will remove the smallest cubes first. The result depends on the
+  order of the cubes and the time limit, bcp_DoBCLIrredundant() is an alternative.
 
 */
 void bcp_DoBCLMultiCubeContainment(bcp p, bcl l)
@@ -143,9 +335,10 @@ void bcp_DoBCLMultiCubeContainment(bcp p, bcl l)
   int reduceCnt = 0;
   int step = 1;
   clock_t t0, t1;
+  bcp_InvalidateBCLVarCnt(p, l);        // flags are modified directly
 
   logprint(5, "bcp_DoBCLMultiCubeContainment start, bcl size=%d", l->cnt);  
-  t1 = t0 = clock();
+  t1 = t0 = bcp_GetMonotonicClock();           // wall clock, clock() would add the time of all threads
 
   for( i = 0; i < l->cnt; i++ )
   {
@@ -164,12 +357,17 @@ void bcp_DoBCLMultiCubeContainment(bcp p, bcl l)
     {
       if ( l->flags[i] == 0 && vcl[i] == vc )
       {
-        if ( bcp_IsBCLCubeRedundant(p, l, i) )
+        if ( bcp_CheckGovernor(p) == 0 )
+          t1 = t0 + p->clock_do_bcl_multi_cube_containment + 1;   // budget exceeded, stop like with the time limit
+        else
         {
-          l->flags[i] = 1;
-	  reduceCnt++;
+          if ( bcp_IsBCLCubeRedundant(p, l, i) )
+          {
+            l->flags[i] = 1;
+	    reduceCnt++;
+          }
+	  t1 = bcp_GetMonotonicClock();
         }
-	t1 = clock();
 	logprint(6, "bcp_DoBCLMultiCubeContainment, step %d/%d, varcnt=%d [%d, %d], reduce cnt=%d, clock %lu/%lu", step, l->cnt, vc, min, max, reduceCnt, t1-t0, p->clock_do_bcl_multi_cube_containment); 
 	step++;
 	if ( t1-t0 > p->clock_do_bcl_multi_cube_containment )
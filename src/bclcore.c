@@ -29,6 +29,9 @@ bcl bcp_NewBCL(bcp p)
     l->last_deleted = -1;
     l->list = NULL;
     l->flags = NULL;
+    l->var_cnt_list = NULL;
+    l->is_var_cnt_valid = 0;
+    l->spill_fd = -1;
     return l;
   }
   return NULL;
@@ -45,20 +48,23 @@ bcl bcp_NewBCLByBCL(bcp p, bcl l)
       n->max = 0;
       return n;
     }
-    n->list = (__m128i *)malloc(l->cnt*p->bytes_per_cube_cnt);
-    if ( n->list != NULL )
+    if ( bcp_ResizeBCLList(p, n, l->cnt) != 0 )         // also allocates the flags
     {
-      n->flags = (uint8_t *)malloc(l->cnt*sizeof(uint8_t));
-      if ( n->flags != NULL )
+      n->cnt = l->cnt;
+      memcpy(n->list, l->list, l->cnt*p->bytes_per_cube_cnt);
+      memcpy(n->flags, l->flags, l->cnt*sizeof(uint8_t));
+      if ( l->is_var_cnt_valid )
       {
-        n->cnt = l->cnt;
-        n->max = l->cnt;
-        memcpy(n->list, l->list, l->cnt*p->bytes_per_cube_cnt);
-        memcpy(n->flags, l->flags, l->cnt*sizeof(uint8_t));
-        return n;
+        n->var_cnt_list = (uint32_t *)malloc(bcp_GetVarCntListSize(p)*sizeof(uint32_t));
+        if ( n->var_cnt_list != NULL )
+        {
+          memcpy(n->var_cnt_list, l->var_cnt_list, bcp_GetVarCntListSize(p)*sizeof(uint32_t));
+          n->is_var_cnt_valid = 1;
+        }
       }
-      free(n->list);
+      return n;
     }
+    free(n->flags);
     free(n);
   }
   return NULL;
@@ -89,25 +95,11 @@ int bcp_CopyBCL(bcp p, bcl a, bcl b)
 {
   if ( a->max < b->cnt )
   {
-    __m128i *list;
-    uint8_t *flags;
-    if ( a->list == NULL )
-      list = (__m128i *)malloc(b->cnt*p->bytes_per_cube_cnt);
-    else
-      list = (__m128i *)realloc(a->list, b->cnt*p->bytes_per_cube_cnt);
-    if ( list == NULL )
-      return 0;
-    a->list = list;
-    if ( a->flags == NULL )
-      flags = (uint8_t *)malloc(b->cnt*sizeof(uint8_t));
-    else
-      flags = (uint8_t *)realloc(a->flags, b->cnt*sizeof(uint8_t));
-    if ( flags == 0 )
+    if ( bcp_ResizeBCLList(p, a, b->cnt) == 0 )       // also resizes the flags
       return 0;
-    a->flags = flags;
-    a->max = b->cnt;
   }
   a->cnt = b->cnt;
+  a->is_var_cnt_valid = 0;
   memcpy(a->list, b->list, a->cnt*p->bytes_per_cube_cnt);
   memcpy(a->flags, b->flags, a->cnt*sizeof(uint8_t));
   return 1;
@@ -116,6 +108,7 @@ int bcp_CopyBCL(bcp p, bcl a, bcl b)
 void bcp_ClearBCL(bcp p, bcl l)
 {
   l->cnt = 0;
+  l->is_var_cnt_valid = 0;
 }
 
 
@@ -123,35 +116,20 @@ void bcp_DeleteBCL(bcp p, bcl l)
 {
   if ( l == NULL )
     return;
-  if ( l->list != NULL )
-    free(l->list);
+  bcp_FreeBCLList(p, l);
   if ( l->flags != NULL )
     free(l->flags);
+  if ( l->var_cnt_list != NULL )
+    free(l->var_cnt_list);
   free(l);
 }
 
 #define BCL_EXTEND 32
 int bcp_ExtendBCL(bcp p, bcl l)
 {
-  __m128i *list;
-  uint8_t *flags;
-  if ( l->list == NULL )
-    list = (__m128i *)malloc(BCL_EXTEND*p->bytes_per_cube_cnt);
-  else
-    list = (__m128i *)realloc(l->list, (BCL_EXTEND+l->max)*p->bytes_per_cube_cnt);
-  if ( list == NULL )
-    return 0;
-  l->list = list;
-  if ( l->flags == NULL )
-    flags = (uint8_t *)malloc(BCL_EXTEND*sizeof(uint8_t));
-  else
-    flags = (uint8_t *)realloc(l->flags, (BCL_EXTEND+l->max)*sizeof(uint8_t));
-  if ( flags == 0 )
-    return 0;
-  l->flags = flags;
-  
-  l->max += BCL_EXTEND;
-  return 1;
+  if ( p->gov.cube_limit > 0 && l->max >= p->gov.cube_limit && l != p->stack_cube_list )
+    return bcp_SetGovernorExceeded(p, "cube");
+  return bcp_ResizeBCLList(p, l, BCL_EXTEND+l->max);     // also resizes the flags, a spilled list might grow by more than BCL_EXTEND cubes
 }
 
 #ifndef bcp_GetBCLCube
@@ -253,6 +231,7 @@ void bcp_PurgeBCL(bcp p, bcl l)
   }
   l->cnt = j;  
   memset(l->flags, 0, l->cnt);
+  l->is_var_cnt_valid = 0;      // the deleted cubes might have been counted
 }
 
 
@@ -269,12 +248,22 @@ int bcp_AddBCLCube(bcp p, bcl l)
   l->cnt++;
   bcp_ClrCube(p, bcp_GetBCLCube(p, l, l->cnt-1));
   l->flags[l->cnt-1] = 0;
+  l->is_var_cnt_valid = 0;
   return l->cnt-1;
 }
 
-/* add a cube and return its position */
+/* add a cube and return its position, "c" may be a cube of "l" */
 int bcp_AddBCLCubeByCube(bcp p, bcl l, bc c)
 {
+  if ( l->max <= l->cnt && l->list != NULL && c >= l->list && c < l->list + l->max*p->blk_cnt )
+  {
+    /* "c" is part of "l" and will be moved by realloc: remember the position of "c" */
+    size_t c_pos = c - l->list;
+    while ( l->max <= l->cnt )
+      if ( bcp_ExtendBCL(p, l) == 0 )
+        return -1;
+    c = l->list + c_pos;
+  }
   while ( l->max <= l->cnt )
     if ( bcp_ExtendBCL(p, l) == 0 )
       return -1;
@@ -283,6 +272,7 @@ int bcp_AddBCLCubeByCube(bcp p, bcl l, bc c)
   l->cnt++;
   bcp_CopyCube(p, bcp_GetBCLCube(p, l, l->cnt-1), c);  
   l->flags[l->cnt-1] = 0;
+  l->is_var_cnt_valid = 0;
   return l->cnt-1;
 }
 
@@ -382,6 +372,33 @@ int *bcp_GetBCLVarCntList(bcp p, bcl l)
   return vcl;
 }
 
+/*
+  return the number of minterms of "l". The result is only correct, if the cubes of "l" 
+  do not intersect with each other, for example after bcp_SubtractBCL() with BCP_SUBTRACT_DISJOINT.
+  Illegal cubes are ignored.
+*/
+double bcp_GetBCLMintermCount(bcp p, bcl l)
+{
+  int i, k;
+  double m;
+  double sum = 0.0;
+  bc c;
+  for( i = 0; i < l->cnt; i++ )
+  {
+    if ( l->flags[i] == 0 )
+    {
+      c = bcp_GetBCLCube(p, l, i);
+      if ( bcp_IsIllegal(p, c) )
+        continue;
+      m = 1.0;
+      for( k = bcp_GetCubeVariableCount(p, c); k < p->var_cnt; k++ )
+        m *= 2.0;       // each don't care variable doubles the number of minterms
+      sum += m;
+    }
+  }
+  return sum;
+}
+
 /*
   for each cube, flip the variables
     01, 10 --> 11
@@ -401,6 +418,7 @@ void bcp_SetBCLFlipVariables(bcp p, bcl l)
   __m128i dc = _mm_loadu_si128(bcp_GetBCLCube(p, p->global_cube_list, 3));
   uint16_t *ptr;
   
+  bcp_InvalidateBCLVarCnt(p, l);
   for( i = 0; i < l->cnt; i++ )
   {
     c = bcp_GetBCLCube(p,l,i);
@@ -456,6 +474,8 @@ void bcp_SetBCLAllDCToZero(bcp p, bcl l, bcl extra_mask)
   __m128i dc = _mm_loadu_si128(bcp_GetBCLCube(p, p->global_cube_list, 3));
   __m128i mask;
 
+  bcp_InvalidateBCLVarCnt(p, l);
+  
   /* loop over all blocks of the cube */  
 
   for( j = 0; j < p->blk_cnt; j++ )
@@ -0,0 +1,231 @@
+/*
+
+  bclespresso.c
+
+  boolean cube list: ESPRESSO minimization loop
+
+  Boolean Cube Calculator
+  (c) 2024 Oliver Kraus
+  https://github.com/olikraus/boolean_cube
+
+  License: CC BY-SA Attribution-ShareAlike 4.0 International
+  https://creativecommons.org/licenses/by-sa/4.0/
+
+
+  bcp_MinimizeBCLWithEspresso() starts with the result of bcp_MinimizeBCLWithOnSet(),
+  so the result is never worse than the default minimization. Then it repeats the steps
+    REDUCE        make each cube as small as possible, bcp_DoBCLReduce()
+    EXPAND        replace each cube by a prime, bcp_DoBCLExpandWithOffSet() (bclexpand.c)
+    IRREDUNDANT   remove redundant cubes, bcp_DoBCLIrredundant() (bclirredundant.c)
+  until the cost (number of cubes, then number of literals) does not improve.
+  Then LAST_GASP reduces all cubes independently, expands them and adds the
+  new primes to the list. If this improves the cost, then the loop continues.
+
+  REDUCE for a cube "c" of the list "l":
+    The part of "c", which is not covered by the other cubes, is the complement
+    of the cofactor of the other cubes with respect to "c". The cube is replaced
+    by the intersection of "c" with the supercube of this complement. "c" is
+    removed, if the complement is empty.
+
+  The cost of each iteration is stored in p->espresso_stat.
+
+*/
+
+#include "bc.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define BCP_ESPRESSO_MAX_ITERATION_CNT 100
+
+static const char *bcp_minimize_mode_names[] = { "default", "espresso", "exact", NULL };
+
+/* returns BCP_MINIMIZE_MODE_xxx for the name or -1 for unknown names */
+int bcp_GetMinimizeModeByName(const char *name)
+{
+  int i;
+  for( i = 0; bcp_minimize_mode_names[i] != NULL; i++ )
+    if ( strcmp(bcp_minimize_mode_names[i], name) == 0 )
+      return i;
+  return -1;
+}
+
+/* returns the number of literals (variables with zero or one) of all cubes in "l" */
+int bcp_GetBCLLiteralCnt(bcp p, bcl l)
+{
+  int i, v;
+  int cnt = 0;
+  bc c;
+  for( i = 0; i < l->cnt; i++ )
+  {
+    if ( l->flags[i] )
+      continue;
+    c = bcp_GetBCLCube(p, l, i);
+    for( v = 0; v < p->var_cnt; v++ )
+      if ( bcp_GetCubeVar(p, c, v) != 3 )
+        cnt++;
+  }
+  return cnt;
+}
+
+/*
+  reduce the cube "c" with the cubes of "l", the cube at position "exclude" of "l" is ignored.
+  returns 1 if "c" has been reduced, 0 if "c" is covered by the other cubes, -1 for memory error or budget exceeded
+*/
+static int bcp_do_reduce_cube(bcp p, bcl l, int exclude, bc c)
+{
+  int i, b;
+  bcl cof;
+  bcl comp;
+  __m128i sc;
+  bc d;
+
+  cof = bcp_NewBCLIntersectingCofactorByCube(p, l, c, exclude);    // bccofactor.c
+  if ( cof == NULL )
+    return -1;
+  comp = bcp_NewBCLComplement(p, cof);
+  bcp_DeleteBCL(p, cof);
+  if ( comp == NULL )
+    return -1;
+  if ( comp->cnt == 0 )
+    return bcp_DeleteBCL(p, comp), 0;
+  for( b = 0; b < p->blk_cnt; b++ )
+  {
+    sc = _mm_setzero_si128();
+    for( i = 0; i < comp->cnt; i++ )
+    {
+      d = bcp_GetBCLCube(p, comp, i);
+      sc = _mm_or_si128(sc, _mm_loadu_si128(d+b));
+    }
+    _mm_storeu_si128(c+b, _mm_and_si128(_mm_loadu_si128(c+b), sc));
+  }
+  bcp_DeleteBCL(p, comp);
+  return 1;
+}
+
+/*
+  REDUCE: replace each cube of "l" by the smallest cube, which still covers the
+  minterms of the cube, which are not covered by the other cubes. The cubes are
+  reduced one after the other, so the result depends on the order of the cubes.
+  returns 0 for memory error or budget exceeded
+*/
+int bcp_DoBCLReduce(bcp p, bcl l)
+{
+  int i, r;
+  bcp_InvalidateBCLVarCnt(p, l);        // cubes are modified directly
+  for( i = 0; i < l->cnt; i++ )
+  {
+    if ( l->flags[i] )
+      continue;
+    r = bcp_do_reduce_cube(p, l, i, bcp_GetBCLCube(p, l, i));
+    if ( r < 0 )
+      return bcp_PurgeBCL(p, l), 0;
+    if ( r == 0 )
+      l->flags[i] = 1;          // "c" is covered by the other cubes
+  }
+  bcp_PurgeBCL(p, l);
+  return 1;
+}
+
+/*
+  LAST_GASP: reduce each cube with all other cubes of "l" (not one after the other),
+  expand the reduced cubes and add the new primes to "l". Finally remove the redundant cubes.
+  returns 0 for memory error or budget exceeded
+*/
+static int bcp_do_bcl_last_gasp(bcp p, bcl l, bcl off)
+{
+  int i, r;
+  bcl reduced = bcp_NewBCLByBCL(p, l);
+  if ( reduced == NULL )
+    return 0;
+  for( i = 0; i < l->cnt; i++ )
+  {
+    r = bcp_do_reduce_cube(p, l, i, bcp_GetBCLCube(p, reduced, i));
+    if ( r < 0 )
+      return bcp_DeleteBCL(p, reduced), 0;
+    if ( r == 0 )
+      reduced->flags[i] = 1;
+  }
+  bcp_PurgeBCL(p, reduced);
+  bcp_DoBCLExpandWithOffSet(p, reduced, off);
+  if ( bcp_AddBCLCubesByBCL(p, l, reduced) == 0 )
+    return bcp_DeleteBCL(p, reduced), 0;
+  bcp_DeleteBCL(p, reduced);
+  bcp_DoBCLSingleCubeContainment(p, l);
+  bcp_DoBCLIrredundant(p, l);
+  return 1;
+}
+
+/* store the cost of "l" in p->espresso_stat, returns 0 for memory error */
+static int bcp_add_espresso_stat(bcp p, bcl l, int *cube_cnt, int *literal_cnt)
+{
+  struct bcp_espresso_stat_struct *st = &(p->espresso_stat);
+  void *ptr;
+  *cube_cnt = l->cnt;
+  *literal_cnt = bcp_GetBCLLiteralCnt(p, l);
+  if ( st->iteration_cnt >= st->list_max )
+  {
+    st->list_max = st->list_max*2 + 16;
+    if ( (ptr = realloc(st->cube_cnt_list, st->list_max*sizeof(int))) == NULL ) return 0;
+    st->cube_cnt_list = (int *)ptr;
+    if ( (ptr = realloc(st->literal_cnt_list, st->list_max*sizeof(int))) == NULL ) return 0;
+    st->literal_cnt_list = (int *)ptr;
+  }
+  st->cube_cnt_list[st->iteration_cnt] = *cube_cnt;
+  st->literal_cnt_list[st->iteration_cnt] = *literal_cnt;
+  st->iteration_cnt++;
+  return 1;
+}
+
+/*
+  minimize "l" with the ESPRESSO loop (see above)
+  The result is not changed, if the calculation of the off-set fails (memory error or budget exceeded).
+*/
+void bcp_MinimizeBCLWithEspresso(bcp p, bcl l)
+{
+  bcl off;
+  bcl best;
+  int cube_cnt, literal_cnt;
+  int best_cube_cnt, best_literal_cnt;
+  int is_last_gasp;
+
+  p->espresso_stat.iteration_cnt = 0;
+  logprint(2, "bcp_MinimizeBCLWithEspresso, initial bcl size=%d", l->cnt );
+  bcp_MinimizeBCLWithOnSet(p, l);      // initial prime and irredundant cover, bclminimize.c
+  off = bcp_NewBCLComplement(p, l);
+  if ( off == NULL )
+    return;     // memory error or budget exceeded, keep "l"
+  best = bcp_NewBCLByBCL(p, l);
+  if ( best == NULL || bcp_add_espresso_stat(p, l, &best_cube_cnt, &best_literal_cnt) == 0 )
+    return bcp_DeleteBCL(p, best), bcp_DeleteBCL(p, off), (void)0;
+
+  while( p->espresso_stat.iteration_cnt < BCP_ESPRESSO_MAX_ITERATION_CNT )
+  {
+    is_last_gasp = 0;
+    if ( bcp_DoBCLReduce(p, l) == 0 )
+      break;
+    bcp_DoBCLExpandWithOffSet(p, l, off);
+    bcp_DoBCLIrredundant(p, l);
+    if ( bcp_IsGovernorExceeded(p) || bcp_add_espresso_stat(p, l, &cube_cnt, &literal_cnt) == 0 )
+      break;
+    if ( cube_cnt > best_cube_cnt || (cube_cnt == best_cube_cnt && literal_cnt >= best_literal_cnt) )
+    {
+      /* no improvement, try LAST_GASP with the best result */
+      if ( bcp_CopyBCL(p, l, best) == 0 || bcp_do_bcl_last_gasp(p, l, off) == 0 )
+        break;
+      if ( bcp_IsGovernorExceeded(p) || bcp_add_espresso_stat(p, l, &cube_cnt, &literal_cnt) == 0 )
+        break;
+      if ( cube_cnt > best_cube_cnt || (cube_cnt == best_cube_cnt && literal_cnt >= best_literal_cnt) )
+        break;
+      is_last_gasp = 1;
+    }
+    if ( bcp_CopyBCL(p, best, l) == 0 )
+      break;
+    best_cube_cnt = cube_cnt;
+    best_literal_cnt = literal_cnt;
+    logprint(3, "bcp_MinimizeBCLWithEspresso, iteration %d, cubes=%d, literals=%d%s", p->espresso_stat.iteration_cnt, cube_cnt, literal_cnt, is_last_gasp ? " (last gasp)" : "");
+  }
+  bcp_CopyBCL(p, l, best);
+  bcp_DeleteBCL(p, best);
+  bcp_DeleteBCL(p, off);
+  logprint(2, "bcp_MinimizeBCLWithEspresso, result bcl size=%d, iterations=%d", l->cnt, p->espresso_stat.iteration_cnt );
+}
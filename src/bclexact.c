@@ -0,0 +1,209 @@
+/*
+
+  bclexact.c
+
+  boolean cube list: exact two level minimization
+
+  Boolean Cube Calculator
+  (c) 2024 Oliver Kraus
+  https://github.com/olikraus/boolean_cube
+
+  License: CC BY-SA Attribution-ShareAlike 4.0 International
+  https://creativecommons.org/licenses/by-sa/4.0/
+
+
+  bcp_MinimizeBCLExact() calculates a cover with the minimum number of cubes:
+
+  1. All primes with the unate recursive method (R. Brayton et al.):
+      P(F) = SCC( !x & P(F_!x) + x & P(F_x) + P(F_!x) & P(F_x) )
+    where x is the most binate variable and the last term contains the pairwise
+    intersections of the primes of both cofactors. If F is unate, then the
+    primes are the cubes of F after single cube containment.
+
+  2. Unate covering problem for the primes with bcp_DoBCLExactIrredundant():
+    essential primes, row and column dominance, branch and bound with a lower bound
+    (see bclirredundant.c).
+
+  Both steps are limited by the resource governor (see bcgovernor.c). If the budget
+  is exceeded or the problem is too large, then the governor is restarted and the
+  heuristic bcp_MinimizeBCLWithEspresso() is used instead. If the covering problem
+  was aborted by the governor and its best cover has fewer cubes, then that cover
+  is the result.
+
+*/
+
+#include "bc.h"
+#include <assert.h>
+
+#define BCP_EXACT_MAX_VAR_CNT 20
+#define BCP_EXACT_MAX_PRIME_CNT 8192
+
+/*
+  cofactor for the literal with "value" (1 or 2) at "var_pos": only the cubes,
+  which intersect with the literal, the variable is set to don't care
+*/
+static bcl bcp_new_bcl_prime_cofactor(bcp p, bcl l, int var_pos, unsigned value)
+{
+  int i, pos;
+  bcl n = bcp_NewBCL(p);
+  if ( n == NULL )
+    return NULL;
+  for( i = 0; i < l->cnt; i++ )
+  {
+    if ( (bcp_GetCubeVar(p, bcp_GetBCLCube(p, l, i), var_pos) & value) != 0 )
+    {
+      pos = bcp_AddBCLCubeByCube(p, n, bcp_GetBCLCube(p, l, i));
+      if ( pos < 0 )
+        return bcp_DeleteBCL(p, n), NULL;
+      bcp_SetCubeVar(p, bcp_GetBCLCube(p, n, pos), var_pos, 3);
+    }
+  }
+  return n;
+}
+
+/*
+  all primes of "l", "l" must not contain illegal cubes.
+  returns NULL for memory error or if the budget is exceeded
+*/
+static bcl bcp_new_bcl_primes(bcp p, bcl l)
+{
+  int var_pos;
+  int i, j, pos;
+  bcl f0;
+  bcl f1;
+  bcl p0;
+  bcl p1;
+  bcl result;
+  bc c;
+
+  if ( bcp_CheckGovernor(p) == 0 )
+    return NULL;        // budget exceeded
+
+  var_pos = bcp_GetBCLMaxBinateSplitVariable(p, l);
+  if ( var_pos < 0 )
+  {
+    /* unate leaf: the primes are the cubes, which are not contained in other cubes */
+    result = bcp_NewBCLByBCL(p, l);
+    if ( result == NULL )
+      return NULL;
+    bcp_DoBCLSingleCubeContainment(p, result);
+    return result;
+  }
+
+  f0 = bcp_new_bcl_prime_cofactor(p, l, var_pos, 1);
+  f1 = bcp_new_bcl_prime_cofactor(p, l, var_pos, 2);
+  if ( f0 == NULL || f1 == NULL )
+    return bcp_DeleteBCL(p, f0), bcp_DeleteBCL(p, f1), NULL;
+  p0 = bcp_new_bcl_primes(p, f0);
+  p1 = p0 == NULL ? NULL : bcp_new_bcl_primes(p, f1);
+  bcp_DeleteBCL(p, f0);
+  bcp_DeleteBCL(p, f1);
+  if ( p0 == NULL || p1 == NULL )
+    return bcp_DeleteBCL(p, p0), bcp_DeleteBCL(p, p1), NULL;
+
+  result = bcp_NewBCL(p);
+  if ( result == NULL )
+    return bcp_DeleteBCL(p, p0), bcp_DeleteBCL(p, p1), NULL;
+
+  /* primes with don't care for "var_pos": pairwise intersection of the primes of both cofactors */
+  for( i = 0; i < p0->cnt; i++ )
+  {
+    if ( bcp_CheckGovernor(p) == 0 )
+      break;
+    for( j = 0; j < p1->cnt; j++ )
+    {
+      if ( bcp_IsIntersectionCube(p, bcp_GetBCLCube(p, p0, i), bcp_GetBCLCube(p, p1, j)) == 0 )
+        continue;
+      pos = bcp_AddBCLCubeByCube(p, result, bcp_GetBCLCube(p, p0, i));
+      if ( pos < 0 )
+        break;
+      c = bcp_GetBCLCube(p, result, pos);
+      bcp_IntersectionCube(p, c, c, bcp_GetBCLCube(p, p1, j));
+    }
+    if ( j < p1->cnt )
+      break;
+  }
+  if ( i < p0->cnt )
+    return bcp_DeleteBCL(p, result), bcp_DeleteBCL(p, p0), bcp_DeleteBCL(p, p1), NULL;
+
+  /* primes of the cofactors with the literal for "var_pos" */
+  for( i = 0; i < p0->cnt; i++ )
+    bcp_SetCubeVar(p, bcp_GetBCLCube(p, p0, i), var_pos, 1);
+  for( i = 0; i < p1->cnt; i++ )
+    bcp_SetCubeVar(p, bcp_GetBCLCube(p, p1, i), var_pos, 2);
+  if ( bcp_AddBCLCubesByBCL(p, result, p0) == 0 || bcp_AddBCLCubesByBCL(p, result, p1) == 0 )
+    return bcp_DeleteBCL(p, result), bcp_DeleteBCL(p, p0), bcp_DeleteBCL(p, p1), NULL;
+  bcp_DeleteBCL(p, p0);
+  bcp_DeleteBCL(p, p1);
+  bcp_DoBCLSingleCubeContainment(p, result);
+  return result;
+}
+
+/* returns a new list with all primes of "l" or NULL for memory error or if the budget is exceeded */
+bcl bcp_NewBCLPrimes(bcp p, bcl l)
+{
+  int i;
+  bcl c;
+  bcl result;
+
+  c = bcp_NewBCLByBCL(p, l);
+  if ( c == NULL )
+    return NULL;
+  for( i = 0; i < c->cnt; i++ )
+    if ( bcp_IsIllegal(p, bcp_GetBCLCube(p, c, i)) )
+      c->flags[i] = 1;          // illegal cubes do not contribute to the function
+  bcp_PurgeBCL(p, c);
+  bcp_DoBCLSingleCubeContainment(p, c);
+  result = bcp_new_bcl_primes(p, c);
+  bcp_DeleteBCL(p, c);
+  return result;
+}
+
+/* returns the number of variables, which are not don't care in all cubes of "l", or -1 for memory error */
+static int bcp_get_bcl_used_var_cnt(bcp p, bcl l)
+{
+  int v, cnt = 0;
+  if ( bcp_CalcBCLBinateSplitVariableTable(p, l) == 0 )
+    return -1;
+  for( v = 0; v < p->var_cnt; v++ )
+    if ( l->var_cnt_list[bcp_GetVarCntZeroPos(p, v)] + l->var_cnt_list[bcp_GetVarCntOnePos(p, v)] > 0 )
+      cnt++;
+  return cnt;
+}
+
+/*
+  replace "l" by a cover with the minimum number of cubes.
+  returns 1 if the result is minimal. returns 0 if the heuristic minimization
+  has been used instead (too many variables or primes, budget exceeded or memory error).
+*/
+int bcp_MinimizeBCLExact(bcp p, bcl l)
+{
+  bcl primes = NULL;
+  int var_cnt;
+
+  logprint(2, "bcp_MinimizeBCLExact, initial bcl size=%d", l->cnt );
+  var_cnt = bcp_get_bcl_used_var_cnt(p, l);
+  if ( var_cnt >= 0 && var_cnt <= BCP_EXACT_MAX_VAR_CNT )
+  {
+    primes = bcp_NewBCLPrimes(p, l);
+    if ( primes != NULL && primes->cnt <= BCP_EXACT_MAX_PRIME_CNT && bcp_DoBCLExactIrredundant(p, primes) != 0 )
+    {
+      if ( bcp_CopyBCL(p, l, primes) != 0 )
+      {
+        bcp_DeleteBCL(p, primes);
+        logprint(2, "bcp_MinimizeBCLExact, result bcl size=%d", l->cnt );
+        return 1;
+      }
+    }
+  }
+  logprint(2, "bcp_MinimizeBCLExact, fallback to heuristic (variables=%d, primes=%d, budget exceeded=%d)",
+    var_cnt, primes == NULL ? -1 : primes->cnt, bcp_IsGovernorExceeded(p) );
+  if ( bcp_IsGovernorExceeded(p) )
+    bcp_StartGovernor(p);       // new budget for the heuristic
+  bcp_MinimizeBCLWithEspresso(p, l);
+  /* the aborted covering problem might have found a better cover */
+  if ( primes != NULL && primes->cnt < l->cnt )
+    bcp_CopyBCL(p, l, primes);
+  bcp_DeleteBCL(p, primes);
+  return 0;
+}
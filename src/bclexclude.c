@@ -392,6 +392,7 @@ int bcp_DoBCLExcludeGroup(bcp p, bcl l, bc grp)
   bc grp_dc_mask;
   int j;
   __m128i r;
+  bcp_InvalidateBCLVarCnt(p, l);        // cubes are modified directly
   
   bcp_StartCubeStackFrame(p);
   grp_dc_mask = bcp_GetTempCube(p);  // goal is to create a new cube with 00 for not member and 11 for member variables
@@ -441,9 +442,80 @@ int bcp_DoBCLExcludeGroupList(bcp p, bcl l, bcl grp_list)
   return 1;
 }
 
+/*
+  returns 1, if bcp_DoBCLXGroup() would remove the cube "c" and all cubes derived from "c"
+  returns 0, if at least one cube would survive, -1 for memory error
+  "work" is an empty list, which is used if some variables are member of more than one group
+  
+  A cube is always removed, if a group has two or more one members, or if all members 
+  are zero: the other groups can only replace don't cares, so this does not depend on 
+  the order of the groups. If the groups are disjoint, then any other cube survives.
+*/
+int bcp_IsCubeXGroupEmpty(bcp p, bc c, bcl work)
+{
+  int i, j, h;
+  int is_overlap = 0;
+  int one_cnt, zero_cnt, dc_cnt;
+  uint64_t m, w, lo, hi;
+  uint64_t *seen;       // members of the previous groups
+  bc g;
+  
+  bcp_StartCubeStackFrame(p);
+  seen = (uint64_t *)bcp_GetTempCube(p);
+  if ( seen == NULL )
+    return bcp_EndCubeStackFrame(p), -1;
+  memset(seen, 0, p->bytes_per_cube_cnt);
+  for( i = 0; i < p->exclude_group_list->cnt; i++ )
+  {
+    g = bcp_GetBCLCube(p, p->exclude_group_list, i);       // 10 for the group members, 11 for all other variables
+    one_cnt = 0;
+    zero_cnt = 0;
+    dc_cnt = 0;
+    for( j = 0; j < p->blk_cnt; j++ )
+    {
+      for( h = 0; h < 2; h++ )
+      {
+        m = ~((uint64_t *)(g+j))[h] & 0x5555555555555555ULL;   // 01 for each member
+        if ( (m & seen[2*j+h]) != 0 )
+          is_overlap = 1;
+        seen[2*j+h] |= m;
+        w = ((uint64_t *)(c+j))[h];
+        lo = w & m;
+        hi = (w >> 1) & m;
+        one_cnt += __builtin_popcountll(hi & ~lo);
+        zero_cnt += __builtin_popcountll(lo & ~hi);
+        dc_cnt += __builtin_popcountll(lo & hi);
+      }
+    }
+    if ( one_cnt >= 2 || (one_cnt == 0 && zero_cnt > 0 && dc_cnt == 0) )
+      return bcp_EndCubeStackFrame(p), 1;
+  }
+  bcp_EndCubeStackFrame(p);
+  if ( is_overlap == 0 )
+    return 0;
+  
+  /* overlapping groups: apply the groups to a copy of "c" */
+  bcp_ClearBCL(p, work);
+  if ( bcp_AddBCLCubeByCube(p, work, c) < 0 )
+    return -1;
+  if ( bcp_DoBCLExcludeGroupList(p, work, p->exclude_group_list) == 0 )
+    return -1;
+  return work->cnt == 0;
+}
+
 int bcp_DoBCLXGroup(bcp p, bcl l)
 {
+  struct bcp_result_cache_struct key;
+  struct bcp_result_cache_struct *e;
+  int is_key;
   if ( l == NULL )
     return 1;
-  return bcp_DoBCLExcludeGroupList(p, l, p->exclude_group_list);
+  is_key = bcp_GetResultCacheKey(p, &key, BCP_RESULT_CACHE_XGROUP, l, p->exclude_group_list);   // bclcache.c
+  if ( is_key && (e = bcp_FindResultCache(p, &key)) != NULL )
+    return bcp_CopyBCL(p, l, e->result);
+  if ( bcp_DoBCLExcludeGroupList(p, l, p->exclude_group_list) == 0 )
+    return 0;
+  if ( is_key )
+    bcp_AddResultCacheBCL(p, &key, l);       // ignore memory errors, the result is just not cached
+  return 1;
 }
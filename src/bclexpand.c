@@ -13,118 +13,125 @@
 
 */
 #include "bc.h"
+#include <stdlib.h>
+#include <string.h>
 #include <assert.h>
 #include <time.h>
 
 /*
-  try to expand cubes into another cube
+  Simple expand (Quine-McCluskey merge)
+  
+  Two cubes, which are equal except for one variable "v", which is zero in the first
+  and one in the second cube, are merged into one cube with a don't care for "v".
+  For each variable the cubes with a zero in "v" are stored in a hash table. The 
+  key is the hash of the cube. The cubes with a one in "v" are searched with
+  the hash of the cube, where "v" is temporarily set to zero. So all pairs are found 
+  with one table lookup per cube and variable instead of comparing all pairs of cubes.
+  The passes over all variables are repeated until no more cubes are merged.
+*/
+
+struct bcp_expand_hash_struct
+{
+  uint64_t hash;
+  int pos;              // position of the cube in the list, -1 for an empty entry
+};
+
+static uint64_t bcp_get_cube_hash(bcp p, bc c)
+{
+  int i;
+  uint64_t h = 0;
+  uint64_t *w = (uint64_t *)c;
+  for( i = 0; i < 2*p->blk_cnt; i++ )
+  {
+    h = (h ^ w[i]) * 0x9E3779B97F4A7C15ULL;
+    h ^= h >> 29;
+  }
+  return h;
+}
+
+/* merge the cubes, which differ only in variable "v", returns the number of merged cubes */
+static int bcp_do_bcl_simple_expand_var(bcp p, bcl l, unsigned v, struct bcp_expand_hash_struct *table, int mask)
+{
+  int i, k;
+  int merge_cnt = 0;
+  uint64_t h;
+  bc c, d;
+  
+  for( k = 0; k <= mask; k++ )
+    table[k].pos = -1;
+  for( i = 0; i < l->cnt; i++ )
+  {
+    c = bcp_GetBCLCube(p, l, i);
+    if ( l->flags[i] == 0 && bcp_GetCubeVar(p, c, v) == 1 )
+    {
+      h = bcp_get_cube_hash(p, c);
+      for( k = h & mask; table[k].pos >= 0; k = (k+1) & mask )
+        ;
+      table[k].hash = h;
+      table[k].pos = i;
+    }
+  }
+  for( i = 0; i < l->cnt; i++ )
+  {
+    d = bcp_GetBCLCube(p, l, i);
+    if ( l->flags[i] != 0 || bcp_GetCubeVar(p, d, v) != 2 )
+      continue;
+    bcp_SetCubeVar(p, d, v, 1);         // the hash of the cube with a zero in "v"
+    h = bcp_get_cube_hash(p, d);
+    for( k = h & mask; table[k].pos >= 0; k = (k+1) & mask )
+    {
+      c = bcp_GetBCLCube(p, l, table[k].pos);
+      if ( table[k].hash == h && l->flags[table[k].pos] == 0 && bcp_GetCubeVar(p, c, v) == 1 && bcp_CompareCube(p, c, d) == 0 )
+      {
+        bcp_SetCubeVar(p, c, v, 3);     // "c" covers both cubes
+        l->flags[i] = 1;
+        merge_cnt++;
+        break;
+      }
+    }
+    bcp_SetCubeVar(p, d, v, 2);
+  }
+  return merge_cnt;
+}
+
+/*
+  merge cubes with distance 1 (see above)
   includes bcp_DoBCLSingleCubeContainment
 */
 void bcp_DoBCLSimpleExpand(bcp p, bcl l)
 {
   clock_t start = clock();
   clock_t end;
-  int i, j, v;
-  int k;
-  int cnt = l->cnt;
-  int delta;
-  int cval, dval;
-  
+  unsigned v;
+  int mask;
+  int merge_cnt;
   int expand_cnt = 0;
-  int reduce_cnt = 0;
-  bc c, d;
-  for( i = 0; i < cnt; i++ )
+  int round_cnt = 0;
+  struct bcp_expand_hash_struct *table;
+  
+  bcp_DoBCLSingleCubeContainment(p, l);         // remove duplicates, each cube can be merged only once in each pass
+  for( mask = 15; mask < 2*l->cnt; mask = mask*2+1 )
+    ;
+  table = (struct bcp_expand_hash_struct *)malloc((mask+1)*sizeof(struct bcp_expand_hash_struct));
+  if ( table == NULL )
+    return;     // memory error, "l" is not expanded
+  bcp_InvalidateBCLVarCnt(p, l);        // cubes are modified directly
+  do
   {
-    if ( l->flags[i] == 0 )
+    merge_cnt = 0;
+    for( v = 0; v < p->var_cnt; v++ )
     {
-      c = bcp_GetBCLCube(p, l, i);
-      for( j = i+1; j < cnt; j++ )
-      {
-        if ( l->flags[j] == 0 )
-        {
-          //if ( i != j )
-          {
-            d = bcp_GetBCLCube(p, l, j); 
-            delta = bcp_GetCubeDelta(p, c, d);              // maybe we can have a new function which returns the variable if the delta is 1
-            //printf("delta=%d\n", delta);
-            
-            if ( delta == 1 )
-            {
-              // search for the variable, which causes the delta
-              for( v = 0; v < p->var_cnt; v++ )
-              {
-                cval = bcp_GetCubeVar(p, c, v);
-                dval = bcp_GetCubeVar(p, d, v);
-                if ( (cval & dval) == 0 )
-                {
-                  break;
-                }
-              }
-              if ( v < p->var_cnt )
-              {
-                //printf("v=%d\n", v);
-                bcp_SetCubeVar(p, c, v, 3-cval);
-                /*
-                  test, whether second arg is a subset of first
-                  returns:      
-                    1: yes, second arg is a subset of first arg
-                    0: no, second arg is not a subset of first arg
-                */
-                if ( bcp_IsSubsetCube(p, d, c) )
-                {
-                  // great, expand would be successful
-                  bcp_SetCubeVar(p, c, v, 3);  // expand the cube, by adding don't care to that variable
-                  expand_cnt++;
-                  //printf("v=%d success c\n", v);
-
-                  /* check whether other cubes are covered by the new cube */
-                  for( k = 0; k < cnt; k++ )
-                  {
-                    if ( k != j && k != i && l->flags[k] == 0)
-                    {
-                      if ( bcp_IsSubsetCube(p, c, bcp_GetBCLCube(p, l, k)) != 0 )
-                      {
-                        l->flags[k] = 1;      // mark the k cube as deleted
-                        reduce_cnt++;
-                      }
-                    }
-                  } // for k
-                }
-                else
-                {
-                  bcp_SetCubeVar(p, c, v, cval);  // revert variable
-                  bcp_SetCubeVar(p, d, v, 3-dval);
-                  if ( bcp_IsSubsetCube(p, c, d) )
-                  {
-                    // expand of d would be successful
-                    bcp_SetCubeVar(p, d, v, 3);  // expand the d cube, by adding don't care to that variable
-                    //printf("v=%d success d\n", v);
-                    for( k = 0; k < cnt; k++ )
-                    {
-                      if ( k != j && k != i && l->flags[k] == 0)
-                      {
-                        if ( bcp_IsSubsetCube(p, d, bcp_GetBCLCube(p, l, k)) != 0 )
-                        {
-                          l->flags[k] = 1;      // mark the k cube as deleted
-                        }
-                      }
-                    } // for k
-                  }
-                  else
-                  {
-                    bcp_SetCubeVar(p, d, v, dval);  // revert variable
-                  }
-                }
-              }
-            }
-          } // j != i
-        } // j cube not deleted
-      } // j loop
-    } // i cube not deleted
-  } // i loop
-  bcp_PurgeBCL(p, l);
+      if ( bcp_CheckGovernor(p) == 0 )
+        break;    // budget exceeded
+      merge_cnt += bcp_do_bcl_simple_expand_var(p, l, v, table, mask);
+    }
+    expand_cnt += merge_cnt;
+    round_cnt++;
+  } while( merge_cnt > 0 && v >= p->var_cnt );
+  free(table);
+  bcp_DoBCLSingleCubeContainment(p, l);         // the merged cubes might cover other cubes
   end = clock();
-  logprint(2, "bcp_DoBCLSimpleExpand end, expand_cnt=%d, reduce_cnt=%d clock=%ld", expand_cnt, reduce_cnt,  end-start);
+  logprint(2, "bcp_DoBCLSimpleExpand end, expand_cnt=%d, rounds=%d, bcl size=%d, clock=%ld", expand_cnt, round_cnt, l->cnt, end-start);
 }
 
 /* OBSOLETE */
@@ -133,6 +140,7 @@ void bcp_DoBCLExpandWithOffSet2(bcp p, bcl l, bcl off)
   int i, j, v;
   bc c;
   int cval;
+  bcp_InvalidateBCLVarCnt(p, l);        // cubes are modified directly
   for( i = 0; i < l->cnt; i++ )
   {
     if ( l->flags[i] == 0 )
@@ -162,65 +170,190 @@ void bcp_DoBCLExpandWithOffSet2(bcp p, bcl l, bcl off)
 }
 
 
+/*
+  Blocking matrix expand (Espresso EXPAND with the off-set)
+  
+  A cube "c" of the on-set does not intersect with a cube "r" of the off-set, if there
+  is at least one variable with a zero in one cube and a one in the other cube. The set 
+  of these variables is the row of "r" in the blocking matrix of "c". A set of literals 
+  of "c" can be raised to don't care, if each row keeps at least one of its variables.
+  
+  The rows are calculated once for each cube of the on-set. The literals are raised in 
+  the order of the number of rows, which contain the variable (the literals, which block 
+  the fewest off-set cubes first). A literal, which is the last remaining variable of 
+  a row, must be kept and the rows with that variable are removed from the matrix. 
+  The result is a prime, which replaces "c" (the list does not grow).
+*/
+
+/* position of the variable within the 64 bit words of a cube */
+#define bcp_GetVarWordPos(var) (((var)/64)*2 + ((var)&32)/32)
+#define bcp_GetVarWordBit(var) (((((var)&31)/8)*16 + ((var)&7)*2) & 63)
+
+/* 
+  calculate the blocking matrix of "c": one row (2*p->blk_cnt words with 01 for each blocking variable) for each off-set cube 
+  returns the number of rows or -1 if "c" intersects with an off-set cube 
+*/
+static int bcp_get_blocking_matrix(bcp p, bc c, bcl off, uint64_t *matrix)
+{
+  int i, j, h;
+  int row_cnt = 0;
+  uint64_t w, any;
+  uint64_t *row;
+  __m128i t;
+  bc r;
+  for( i = 0; i < off->cnt; i++ )
+  {
+    if ( off->flags[i] )
+      continue;
+    r = bcp_GetBCLCube(p, off, i);
+    row = matrix + row_cnt*2*p->blk_cnt;
+    any = 0;
+    for( j = 0; j < p->blk_cnt; j++ )
+    {
+      t = _mm_and_si128(_mm_loadu_si128(c+j), _mm_loadu_si128(r+j));
+      for( h = 0; h < 2; h++ )
+      {
+        w = h == 0 ? (uint64_t)_mm_cvtsi128_si64(t) : (uint64_t)_mm_cvtsi128_si64(_mm_unpackhi_epi64(t, t));
+        w = ~(w | (w >> 1)) & 0x5555555555555555ULL;      // 01 for each variable with an empty intersection
+        row[2*j+h] = w;
+        any |= w;
+      }
+    }
+    if ( any == 0 )
+      return -1;
+    row_cnt++;
+  }
+  return row_cnt;
+}
+
+static int bcp_compare_expand_key(const void *a, const void *b)
+{
+  uint64_t x = *(const uint64_t *)a;
+  uint64_t y = *(const uint64_t *)b;
+  return x < y ? -1 : (x > y ? 1 : 0);
+}
+
+/* raise the literals of "c" with the blocking matrix, "key_list" requires p->var_cnt entries, "cnt_list" 2*p->blk_cnt*64 entries */
+static void bcp_do_blocking_matrix_expand(bcp p, bc c, uint64_t *matrix, int row_cnt, uint64_t *key_list, int *cnt_list)
+{
+  int i, k, v, b;
+  int var_cnt = 0;
+  int wcnt = 2*p->blk_cnt;
+  int kw;
+  int is_last;
+  uint64_t w, m;
+  uint64_t *row;
+  
+  /* number of rows for each variable, the position in cnt_list is word*32 + bit/2 */
+  memset(cnt_list, 0, wcnt*32*sizeof(int));
+  for( i = 0; i < row_cnt; i++ )
+  {
+    row = matrix + i*wcnt;
+    for( k = 0; k < wcnt; k++ )
+      for( w = row[k]; w != 0; w &= w-1 )
+        cnt_list[k*32 + __builtin_ctzll(w)/2]++;
+  }
+  
+  /* sort the literals of "c" by the number of rows */
+  for( v = 0; v < p->var_cnt; v++ )
+    if ( bcp_GetCubeVar(p, c, v) != 3 )
+      key_list[var_cnt++] = ((uint64_t)cnt_list[bcp_GetVarWordPos(v)*32 + bcp_GetVarWordBit(v)/2] << 32) | (uint64_t)v;
+  qsort(key_list, var_cnt, sizeof(uint64_t), bcp_compare_expand_key);
+  
+  for( i = 0; i < var_cnt && row_cnt > 0; i++ )
+  {
+    v = (int)(key_list[i] & 0xffffffffULL);
+    kw = bcp_GetVarWordPos(v);
+    m = 1ULL << bcp_GetVarWordBit(v);
+    
+    /* check whether "v" is the last variable of a row */
+    is_last = 0;
+    for( b = 0; b < row_cnt && is_last == 0; b++ )
+    {
+      row = matrix + b*wcnt;
+      if ( row[kw] == m )
+      {
+        for( k = 0; k < wcnt; k++ )
+          if ( k != kw && row[k] != 0 )
+            break;
+        if ( k >= wcnt )
+          is_last = 1;
+      }
+    }
+    
+    for( b = 0; b < row_cnt; b++ )
+    {
+      row = matrix + b*wcnt;
+      if ( row[kw] & m )
+      {
+        if ( is_last )
+        {
+          /* "v" is kept, so the row is not blocking any more: replace the row by the last row */
+          row_cnt--;
+          if ( b < row_cnt )
+            memcpy(row, matrix + row_cnt*wcnt, wcnt*sizeof(uint64_t));
+          b--;
+        }
+        else
+        {
+          row[kw] &= ~m;
+        }
+      }
+    }
+    if ( is_last == 0 )
+      bcp_SetCubeVar(p, c, v, 3);
+  }
+  /* all rows are removed: the remaining literals (if any) do not block an off-set cube */
+  for( ; i < var_cnt; i++ )
+    bcp_SetCubeVar(p, c, (int)(key_list[i] & 0xffffffffULL), 3);
+}
+
+/*
+  replace each cube of "l" by a prime, which does not intersect with "off" (blocking matrix expand, see above)
+  includes bcp_DoBCLSingleCubeContainment
+*/
 void bcp_DoBCLExpandWithOffSet(bcp p, bcl l, bcl off)
 {
-  int i, j, v;
+  int i;
+  int row_cnt;
+  int expand_cnt = 0;
+  uint64_t *matrix;
+  uint64_t *key_list;
+  int *cnt_list;
   bc c;
-  int cval;
-  int is_expanded;      // set to 1 if the cube c had been successfully expanded
-	
+  
   logprint(5, "bcp_DoBCLExpandWithOffSet, bcl onset size=%d, bcl offset size=%d", l->cnt, off->cnt);  
-	
-
-  bcp_StartCubeStackFrame(p);
-  c = bcp_GetTempCube(p);
   
-  for( i = 0; i < l->cnt; i++ ) // l->cnt may grow so new cubes are also analysed
+  matrix = (uint64_t *)malloc((size_t)(off->cnt+1)*p->bytes_per_cube_cnt);
+  key_list = (uint64_t *)malloc((p->var_cnt+1)*sizeof(uint64_t));
+  cnt_list = (int *)malloc(p->blk_cnt*64*sizeof(int));
+  if ( matrix == NULL || key_list == NULL || cnt_list == NULL )
+  {
+    free(matrix), free(key_list), free(cnt_list);
+    return;     // memory error, "l" is not expanded
+  }
+  bcp_InvalidateBCLVarCnt(p, l);        // cubes are modified directly
+  
+  for( i = 0; i < l->cnt; i++ )
   {
-    //logprint(6, "bcp_DoBCLExpandWithOffSet, step %d/%d", i+1, l->cnt);  
+    if ( bcp_CheckGovernor(p) == 0 )
+      break;    // budget exceeded, the remaining cubes are not expanded
     if ( l->flags[i] == 0 )
     {
-      // c = bcp_GetBCLCube(p, l, i);
-      bcp_CopyCube(p, c, bcp_GetBCLCube(p, l, i));
-      is_expanded = 0;
-      for( v = 0; v < p->var_cnt; v++ )
-      {
-        cval = bcp_GetCubeVar(p, c, v);
-        
-        if ( cval != 3 )
-        {
-          bcp_SetCubeVar(p, c, v, 3);  // for testing, set the variable to don't care
-          for( j = 0; j < off->cnt; j++ )       // check whether there is any intersection with the off-set 
-          {
-            if ( off->flags[j] == 0 )
-            {
-              if ( bcp_IsIntersectionCube(p, c, bcp_GetBCLCube(p, off, j)) != 0 )
-              {
-                break;  // intersection found
-              }
-            }
-          } // off-set test
-          if ( j >= off->cnt )  // no intersection found, so this cube was successful expanded
-          {
-            is_expanded = 1;
-            bcp_AddBCLCubeByCube(p, l, c);
-            // c = bcp_GetBCLCube(p, l, i);        // this is tricky: the address of c might have changed due to realloc of the cube list, so re-read c here
-          }
-          bcp_SetCubeVar(p, c, v, cval);    // undo the change for the next test
-        } // dc?
-        
-        
-      } // with all variables in c
-      if ( is_expanded )
+      c = bcp_GetBCLCube(p, l, i);
+      row_cnt = bcp_get_blocking_matrix(p, c, off, matrix);
+      if ( row_cnt >= 0 )       // "c" must not intersect with the off-set
       {
-        // c was expanded, so remove that cube from the list
-        l->flags[i] = 1;
-      }        
-    } // not deleted in l
+        bcp_do_blocking_matrix_expand(p, c, matrix, row_cnt, key_list, cnt_list);
+        expand_cnt++;
+      }
+    }
   }
-  bcp_PurgeBCL(p, l);  // remove all deleted cubes from "l"
+  free(matrix);
+  free(key_list);
+  free(cnt_list);
   bcp_DoBCLSingleCubeContainment(p, l);
-  bcp_EndCubeStackFrame(p);  
+  logprint(5, "bcp_DoBCLExpandWithOffSet, expanded cubes=%d, bcl size=%d", expand_cnt, l->cnt);  
 }
 
 
@@ -230,6 +363,7 @@ void bcp_DoBCLExpandWithCofactor(bcp p, bcl l)
   bc c;
   int cval;
   int is_expanded;      // set to 1 if the cube c had been successfully expanded
+  bcp_InvalidateBCLVarCnt(p, l);        // cubes are modified directly
   
   bcp_StartCubeStackFrame(p);
   c = bcp_GetTempCube(p);
@@ -239,6 +373,8 @@ void bcp_DoBCLExpandWithCofactor(bcp p, bcl l)
   
   for( i = 0; i < l->cnt; i++ ) // l->cnt may grow so new cubes are also analysed
   {
+    if ( bcp_CheckGovernor(p) == 0 )
+      break;    // budget exceeded, the remaining cubes are not expanded
     if ( l->flags[i] == 0 )
     {
       bcp_CopyCube(p, c, bcp_GetBCLCube(p, l, i));
@@ -252,8 +388,8 @@ void bcp_DoBCLExpandWithCofactor(bcp p, bcl l)
           bcp_SetCubeVar(p, c, v, 3);  // for testing, set the variable to don't care
           if ( bcp_IsBCLCubeCovered(p, l, c) ) // still covered, so this cube was successful expanded
           {
-            is_expanded = 1;
-            bcp_AddBCLCubeByCube(p, l, c);
+            if ( bcp_AddBCLCubeByCube(p, l, c) >= 0 )
+              is_expanded = 1;
           }
           bcp_SetCubeVar(p, c, v, cval);    // undo the change for the next test
         } // dc?
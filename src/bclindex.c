@@ -0,0 +1,304 @@
+/*
+
+  bclindex.c
+
+  boolean cube list: inverted literal index for containment queries
+
+  Boolean Cube Calculator
+  (c) 2024 Oliver Kraus
+  https://github.com/olikraus/boolean_cube
+
+  License: CC BY-SA Attribution-ShareAlike 4.0 International
+  https://creativecommons.org/licenses/by-sa/4.0/
+
+
+  For each literal (variable with value zero or one) the index contains the
+  positions of the cubes with that literal (posting list). Cubes without
+  literal and cubes with an illegal (00) variable are stored in an
+  additional list, they are candidates for all queries.
+
+  Queries:
+    bcp_FindBCISupersetCube(): find a cube which contains a given cube
+      A cube "a" contains "c" only if all literals of "a" are also literals
+      of "c": count the hits in the posting lists of the literals of "c"
+      and check the cubes which got a hit for each of their literals.
+    bcp_DoBCISubsetCubeMark(): mark all cubes which are contained in a given cube
+      A cube "b" is contained in "c" only if "b" has all literals of "c":
+      only the cubes of the shortest posting list are checked.
+  All candidates are verified with bcp_IsSubsetCube().
+
+  The index refers to the positions of the cubes in the list. Deleted cubes
+  (flag is set) are skipped, but bcp_PurgeBCL() must not be called while the
+  index is in use. Cubes which are appended to the list can be added to the
+  index with bcp_AddBCICube().
+
+*/
+
+#include "bc.h"
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+/* return the posting list for the literal of variable "var_pos" with value (1 or 2) */
+#define bci_GetPostPos(var_pos, value) (2*(var_pos)+(value)-1)
+
+static int bci_append_post(bci x, int post_pos, int cube_pos)
+{
+  int *list;
+  int max;
+  if ( x->post_len[post_pos] >= x->post_max[post_pos] )
+  {
+    max = x->post_max[post_pos]*2 + 8;
+    list = (int *)realloc(x->post_list[post_pos], max*sizeof(int));
+    if ( list == NULL )
+      return 0;
+    x->post_list[post_pos] = list;
+    x->post_max[post_pos] = max;
+  }
+  x->post_list[post_pos][x->post_len[post_pos]++] = cube_pos;
+  return 1;
+}
+
+static int bci_reserve_cubes(bci x, int cnt)
+{
+  int max;
+  void *ptr;
+  if ( cnt <= x->cube_max )
+    return 1;
+  max = cnt + cnt/2 + 32;
+  if ( (ptr = realloc(x->lit_cnt_list, max*sizeof(int))) == NULL ) return 0;
+  x->lit_cnt_list = (int *)ptr;
+  if ( (ptr = realloc(x->sig_list, max*sizeof(uint64_t))) == NULL ) return 0;
+  x->sig_list = (uint64_t *)ptr;
+  if ( (ptr = realloc(x->hit_list, max*sizeof(uint32_t))) == NULL ) return 0;
+  x->hit_list = (uint32_t *)ptr;
+  if ( (ptr = realloc(x->stamp_list, max*sizeof(uint32_t))) == NULL ) return 0;
+  x->stamp_list = (uint32_t *)ptr;
+  memset(x->stamp_list + x->cube_max, 0, (max - x->cube_max)*sizeof(uint32_t));
+  x->cube_max = max;
+  return 1;
+}
+
+/* add the cube at position "pos" of "l" to the index, returns 0 for memory error */
+int bcp_AddBCICube(bcp p, bci x, bcl l, int pos)
+{
+  int i, h, b;
+  int lit_cnt = 0;
+  int is_special = 0;
+  uint64_t w, nd;
+  unsigned v;
+  bc c = bcp_GetBCLCube(p, l, pos);
+
+  if ( bci_reserve_cubes(x, pos+1) == 0 )
+    return 0;
+  for( i = 0; i < p->blk_cnt; i++ )
+  {
+    for( h = 0; h < 2; h++ )
+    {
+      w = ((uint64_t *)(c+i))[h];
+      nd = ~(w & (w >> 1)) & 0x5555555555555555ULL;   // 01 for each variable, which is not don't care
+      while( nd != 0 )
+      {
+        b = __builtin_ctzll(nd);
+        nd &= nd-1;
+        v = (w >> b) & 3;
+        if ( v == 0 )
+          is_special = 1;
+        else
+        {
+          if ( bci_append_post(x, bci_GetPostPos(i*64 + h*32 + b/2, v), pos) == 0 )
+            return 0;
+          lit_cnt++;
+        }
+      }
+    }
+  }
+  if ( lit_cnt == 0 || is_special )
+    if ( bci_append_post(x, x->post_cnt-1, pos) == 0 )
+      return 0;
+  x->lit_cnt_list[pos] = lit_cnt;
+  x->sig_list[pos] = bcp_GetCubeLiteralSignature(p, c);
+  x->stamp_list[pos] = 0;
+  return 1;
+}
+
+void bcp_DeleteBCI(bcp p, bci x)
+{
+  int i;
+  if ( x == NULL )
+    return;
+  if ( x->post_list != NULL )
+    for( i = 0; i < x->post_cnt; i++ )
+      free(x->post_list[i]);
+  free(x->post_list);
+  free(x->post_len);
+  free(x->post_max);
+  free(x->lit_cnt_list);
+  free(x->sig_list);
+  free(x->hit_list);
+  free(x->stamp_list);
+  free(x);
+}
+
+/* create the index for all cubes of "l", which are not deleted, returns NULL for memory error */
+bci bcp_NewBCI(bcp p, bcl l)
+{
+  int i;
+  bci x = (bci)malloc(sizeof(struct bci_struct));
+  if ( x == NULL )
+    return NULL;
+  memset(x, 0, sizeof(struct bci_struct));
+  x->post_cnt = 2*p->blk_cnt*64+1;       // last list: cubes without literal or with illegal variable
+  x->post_list = (int **)calloc(x->post_cnt, sizeof(int *));
+  x->post_len = (int *)calloc(x->post_cnt, sizeof(int));
+  x->post_max = (int *)calloc(x->post_cnt, sizeof(int));
+  if ( x->post_list == NULL || x->post_len == NULL || x->post_max == NULL || bci_reserve_cubes(x, l->cnt) == 0 )
+    return bcp_DeleteBCI(p, x), NULL;
+  for( i = 0; i < l->cnt; i++ )
+    if ( l->flags[i] == 0 )
+      if ( bcp_AddBCICube(p, x, l, i) == 0 )
+        return bcp_DeleteBCI(p, x), NULL;
+  return x;
+}
+
+/* count one hit for the cube at "pos", returns 1 if all literals of that cube have been hit */
+static int bci_hit(bci x, int pos)
+{
+  if ( x->stamp_list[pos] != x->stamp )
+  {
+    x->stamp_list[pos] = x->stamp;
+    x->hit_list[pos] = 0;
+  }
+  x->hit_list[pos]++;
+  return x->hit_list[pos] == (uint32_t)x->lit_cnt_list[pos];
+}
+
+static void bci_next_stamp(bci x)
+{
+  x->stamp++;
+  if ( x->stamp == 0 )          // wrap around: invalidate all stamps
+  {
+    memset(x->stamp_list, 0, x->cube_max*sizeof(uint32_t));
+    x->stamp = 1;
+  }
+}
+
+/*
+  find a cube in "l", which contains "c" (c is a subset of that cube).
+  The cube at position "exclude" is ignored (use -1 to check all cubes).
+  returns the position of the cube or -1 if there is no such cube
+*/
+int bcp_FindBCISupersetCube(bcp p, bci x, bcl l, bc c, int exclude)
+{
+  int i, h, b, k, pos, post_pos;
+  uint64_t w, nd;
+  unsigned v, vv;
+
+  for( k = 0; k < x->post_len[x->post_cnt-1]; k++ )
+  {
+    pos = x->post_list[x->post_cnt-1][k];
+    if ( pos != exclude && l->flags[pos] == 0 && bcp_IsSubsetCube(p, bcp_GetBCLCube(p, l, pos), c) )
+      return pos;
+  }
+
+  bci_next_stamp(x);
+  for( i = 0; i < p->blk_cnt; i++ )
+  {
+    for( h = 0; h < 2; h++ )
+    {
+      w = ((uint64_t *)(c+i))[h];
+      nd = ~(w & (w >> 1)) & 0x5555555555555555ULL;
+      while( nd != 0 )
+      {
+        b = __builtin_ctzll(nd);
+        nd &= nd-1;
+        v = (w >> b) & 3;
+        for( vv = 1; vv <= 2; vv++ )
+        {
+          if ( v != 0 && v != vv )
+            continue;           // an illegal variable in "c" accepts both literals
+          post_pos = bci_GetPostPos(i*64 + h*32 + b/2, vv);
+          for( k = 0; k < x->post_len[post_pos]; k++ )
+          {
+            pos = x->post_list[post_pos][k];
+            if ( pos != exclude && l->flags[pos] == 0 && bci_hit(x, pos) )
+              if ( bcp_IsSubsetCube(p, bcp_GetBCLCube(p, l, pos), c) )
+                return pos;
+          }
+        }
+      }
+    }
+  }
+  return -1;
+}
+
+/*
+  mark all cubes of "l", which are a subset of "c", as deleted (flag = 1).
+  The cube at position "exclude" is ignored (use -1 to check all cubes).
+  returns the number of marked cubes
+*/
+int bcp_DoBCISubsetCubeMark(bcp p, bci x, bcl l, bc c, int exclude)
+{
+  int i, h, b, k, pos;
+  int post_pos = -1;
+  int mark_cnt = 0;
+  uint64_t w, nd;
+  uint64_t sig = bcp_GetCubeLiteralSignature(p, c);
+  unsigned v;
+
+  /* find the shortest posting list for the literals of "c" */
+  for( i = 0; i < p->blk_cnt; i++ )
+  {
+    for( h = 0; h < 2; h++ )
+    {
+      w = ((uint64_t *)(c+i))[h];
+      nd = ~(w & (w >> 1)) & 0x5555555555555555ULL;
+      while( nd != 0 )
+      {
+        b = __builtin_ctzll(nd);
+        nd &= nd-1;
+        v = (w >> b) & 3;
+        if ( v != 0 )
+        {
+          k = bci_GetPostPos(i*64 + h*32 + b/2, v);
+          if ( post_pos < 0 || x->post_len[k] < x->post_len[post_pos] )
+            post_pos = k;
+        }
+      }
+    }
+  }
+
+  if ( post_pos < 0 )
+  {
+    /* no literal in "c", check all cubes */
+    for( pos = 0; pos < l->cnt; pos++ )
+    {
+      if ( pos != exclude && l->flags[pos] == 0 && bcp_IsSubsetCube(p, c, bcp_GetBCLCube(p, l, pos)) )
+      {
+        l->flags[pos] = 1;
+        mark_cnt++;
+      }
+    }
+    return mark_cnt;
+  }
+
+  /* the candidates are the cubes of the shortest list and the cubes with illegal variables */
+  for( i = 0; i < 2; i++ )
+  {
+    if ( i == 1 )
+      post_pos = x->post_cnt-1;
+    for( k = 0; k < x->post_len[post_pos]; k++ )
+    {
+      pos = x->post_list[post_pos][k];
+      if ( pos != exclude && l->flags[pos] == 0 && (sig & ~x->sig_list[pos]) == 0 )
+      {
+        if ( bcp_IsSubsetCube(p, c, bcp_GetBCLCube(p, l, pos)) )
+        {
+          l->flags[pos] = 1;
+          mark_cnt++;
+        }
+      }
+    }
+  }
+  return mark_cnt;
+}
@@ -13,39 +13,218 @@
 
 */
 #include "bc.h"
+#include <stdlib.h>
 #include <assert.h>
 
 /*
-  calculates the intersection of a and b and stores the result into "result"
-  this will apply SCC
+  Bucket join: a pair of cubes can only intersect, if there is no variable with
+  a zero in one cube and a one in the other cube. The cubes of "a" are sorted into
+  buckets by the values of up to BCP_INTERSECTION_JOIN_VAR_CNT variables. For each 
+  cube of "b" only the buckets with compatible values are visited.
+  
+  The variables are selected with the column statistics (see bccofactor.c): the 
+  fraction of the cube pairs, which are disjoint in a variable, is 
+    (zeros(a)*ones(b) + ones(a)*zeros(b)) / (|a|*|b|)
+  A variable is used, if at least 1/4 of the pairs are removed.
 */
-int bcp_IntersectionBCLs(bcp p, bcl result, bcl a, bcl b)
+
+/* value of a variable within the bucket key: 0 (zero), 1 (one) or 2 (don't care) */
+static int bcp_get_join_key(bcp p, bc c, const int *var_list, int var_cnt)
+{
+  int k;
+  int key = 0;
+  unsigned v;
+  for( k = var_cnt-1; k >= 0; k-- )
+  {
+    v = bcp_GetCubeVar(p, c, var_list[k]);
+    key = key*3 + (v == 1 ? 0 : (v == 2 ? 1 : 2));
+  }
+  return key;
+}
+
+/* returns 0, if all cubes with key "ka" are disjoint with all cubes with key "kb" */
+static int bcp_is_join_key_compatible(int ka, int kb, int var_cnt)
+{
+  int k;
+  for( k = 0; k < var_cnt; k++ )
+  {
+    if ( ka%3 + kb%3 == 1 )     // zero and one
+      return 0;
+    ka /= 3;
+    kb /= 3;
+  }
+  return 1;
+}
+
+/* select the bucket variables, returns the number of variables (0: use the nested loop) or -1 for memory error */
+static int bcp_get_join_var_list(bcp p, bcl a, bcl b, int *var_list)
+{
+  int i, k, var_cnt = 0;
+  double pair_cnt = (double)a->cnt * (double)b->cnt;
+  double disjoint_cnt, best_cnt[BCP_INTERSECTION_JOIN_VAR_CNT];
+  
+  if ( bcp_CalcBCLBinateSplitVariableTable(p, a) == 0 || bcp_CalcBCLBinateSplitVariableTable(p, b) == 0 )
+    return -1;
+  for( i = 0; i < p->var_cnt; i++ )
+  {
+    disjoint_cnt = (double)a->var_cnt_list[bcp_GetVarCntZeroPos(p, i)] * b->var_cnt_list[bcp_GetVarCntOnePos(p, i)]
+      + (double)a->var_cnt_list[bcp_GetVarCntOnePos(p, i)] * b->var_cnt_list[bcp_GetVarCntZeroPos(p, i)];
+    if ( 4*disjoint_cnt < pair_cnt )
+      continue;
+    /* insert into the sorted list of the best variables */
+    for( k = var_cnt; k > 0 && best_cnt[k-1] < disjoint_cnt; k-- )
+    {
+      if ( k < BCP_INTERSECTION_JOIN_VAR_CNT )
+      {
+        best_cnt[k] = best_cnt[k-1];
+        var_list[k] = var_list[k-1];
+      }
+    }
+    if ( k < BCP_INTERSECTION_JOIN_VAR_CNT )
+    {
+      best_cnt[k] = disjoint_cnt;
+      var_list[k] = i;
+      if ( var_cnt < BCP_INTERSECTION_JOIN_VAR_CNT )
+        var_cnt++;
+    }
+  }
+  return var_cnt;
+}
+
+/* 
+  process one pair of cubes: add the intersection to "result" or, if "result" is NULL, 
+  test whether the intersection survives the xgroups ("work" is NULL if there are no xgroups)
+  returns 0 to continue, 1 if a non empty intersection has been found (result == NULL), -1 for memory error
+*/
+static int bcp_intersection_pair(bcp p, bcl result, bcl work, bc tmp, bc a, bc b)
+{
+  int r;
+  if ( bcp_IntersectionCube(p, tmp, a, b) == 0 )
+    return 0;
+  if ( result != NULL )
+    return bcp_AddBCLCubeByCube(p, result, tmp) < 0 ? -1 : 0;
+  if ( work == NULL )
+    return 1;
+  r = bcp_IsCubeXGroupEmpty(p, tmp, work);      // bclexclude.c
+  if ( r < 0 )
+    return -1;
+  return r == 0;
+}
+
+/* returns 0 if all pairs have been processed, 1 if bcp_intersection_pair() has found an intersection, -1 for memory error or budget exceeded */
+static int bcp_intersection_bcl_join(bcp p, bcl result, bcl work, bcl a, bcl b, const int *var_list, int var_cnt, bc tmp)
+{
+  int i, j, t, ka, kb;
+  int r = 0;
+  int key_cnt = 1;
+  int *bucket_start;    // key_cnt+1 entries, cubes of bucket "k" are at bucket_list[bucket_start[k]] ... bucket_list[bucket_start[k+1]-1]
+  int *bucket_list;
+  uint8_t *key_list;
+  uint8_t *compatible;  // key_cnt*key_cnt entries
+  
+  for( i = 0; i < var_cnt; i++ )
+    key_cnt *= 3;
+  bucket_start = (int *)calloc(key_cnt+1, sizeof(int));
+  bucket_list = (int *)malloc(a->cnt*sizeof(int));
+  key_list = (uint8_t *)malloc(a->cnt*sizeof(uint8_t));
+  compatible = (uint8_t *)malloc(key_cnt*key_cnt*sizeof(uint8_t));
+  if ( bucket_start == NULL || bucket_list == NULL || key_list == NULL || compatible == NULL )
+    return free(bucket_start), free(bucket_list), free(key_list), free(compatible), -1;
+  
+  for( ka = 0; ka < key_cnt; ka++ )
+    for( kb = 0; kb < key_cnt; kb++ )
+      compatible[ka*key_cnt+kb] = bcp_is_join_key_compatible(ka, kb, var_cnt);
+  
+  /* counting sort of the cubes of "a" */
+  for( j = 0; j < a->cnt; j++ )
+  {
+    key_list[j] = bcp_get_join_key(p, bcp_GetBCLCube(p, a, j), var_list, var_cnt);
+    bucket_start[key_list[j]+1]++;
+  }
+  for( ka = 0; ka < key_cnt; ka++ )
+    bucket_start[ka+1] += bucket_start[ka];
+  for( j = 0; j < a->cnt; j++ )
+    bucket_list[bucket_start[key_list[j]]++] = j;
+  for( ka = key_cnt; ka > 0; ka-- )
+    bucket_start[ka] = bucket_start[ka-1];
+  bucket_start[0] = 0;
+  
+  for( i = 0; i < b->cnt && r == 0; i++ )
+  {
+    if ( bcp_CheckGovernor(p) == 0 )
+    {
+      r = -1;       // budget exceeded
+      break;
+    }
+    kb = bcp_get_join_key(p, bcp_GetBCLCube(p, b, i), var_list, var_cnt);
+    for( ka = 0; ka < key_cnt && r == 0; ka++ )
+      if ( compatible[ka*key_cnt+kb] )
+        for( t = bucket_start[ka]; t < bucket_start[ka+1] && r == 0; t++ )
+          r = bcp_intersection_pair(p, result, work, tmp, bcp_GetBCLCube(p, a, bucket_list[t]), bcp_GetBCLCube(p, b, i));
+  }
+  free(bucket_start);
+  free(bucket_list);
+  free(key_list);
+  free(compatible);
+  return r;
+}
+
+/* 
+  visit all pairs of cubes of "a" and "b", see bcp_intersection_pair()
+  For large lists the cube pairs are selected with the bucket join (see above).
+  returns 0 if all pairs have been processed, 1 if a non empty intersection has been found, -1 for memory error or budget exceeded 
+*/
+static int bcp_intersection_bcl_loop(bcp p, bcl result, bcl work, bcl a, bcl b)
 {
   int i, j;
+  int r = 0;
+  int var_list[BCP_INTERSECTION_JOIN_VAR_CNT];
+  int var_cnt = 0;
   bc tmp;
   
   bcp_StartCubeStackFrame(p);
   tmp = bcp_GetTempCube(p);
-  
-  assert(result != a);
-  assert(result != b);
-  
-  bcp_ClearBCL(p, result);
-  for( i = 0; i < b->cnt; i++ )
+  if ( (long)a->cnt*b->cnt >= BCP_INTERSECTION_JOIN_MIN_CNT )
+    var_cnt = bcp_get_join_var_list(p, a, b, var_list);
+  if ( var_cnt > 0 )
   {
-    for( j = 0; j < a->cnt; j++ )
+    logprint(5, "bcp_IntersectionBCLs: bucket join with %d variables, bcl a size=%d, bcl b size=%d", var_cnt, a->cnt, b->cnt);
+    r = bcp_intersection_bcl_join(p, result, work, a, b, var_list, var_cnt, tmp);
+  }
+  else if ( var_cnt == 0 )
+  {
+    for( i = 0; i < b->cnt && r == 0; i++ )
     {
-      if ( bcp_IntersectionCube(p, tmp, bcp_GetBCLCube(p, a, j), bcp_GetBCLCube(p, b, i)) )
+      if ( bcp_CheckGovernor(p) == 0 )
       {
-        if ( bcp_AddBCLCubeByCube(p, result, tmp) < 0 )
-          return bcp_EndCubeStackFrame(p), 0;
+        r = -1;       // budget exceeded
+        break;
       }
+      for( j = 0; j < a->cnt && r == 0; j++ )
+        r = bcp_intersection_pair(p, result, work, tmp, bcp_GetBCLCube(p, a, j), bcp_GetBCLCube(p, b, i));
     }
   }
+  else
+  {
+    r = -1;     // memory error
+  }
+  bcp_EndCubeStackFrame(p);
+  return r;
+}
+
+/*
+  calculates the intersection of a and b and stores the result into "result"
+  this will apply SCC
+*/
+int bcp_IntersectionBCLs(bcp p, bcl result, bcl a, bcl b)
+{
+  assert(result != a);
+  assert(result != b);
   
+  bcp_ClearBCL(p, result);
+  if ( bcp_intersection_bcl_loop(p, result, NULL, a, b) < 0 )
+    return 0;
   bcp_DoBCLSingleCubeContainment(p, result);
-
-  bcp_EndCubeStackFrame(p);  
   return 1;
 }
 
@@ -62,4 +241,26 @@ int bcp_IntersectionBCL(bcp p, bcl a, bcl b)
   return 1;
 }
 
-
+/*
+  returns 1 if the intersection of "a" and "b" is empty after bcp_DoBCLXGroup(), 
+  returns 0 if the intersection is not empty, -1 for memory error or budget exceeded.
+  Same as bcp_IntersectionBCL() followed by bcp_DoBCLXGroup() and a test for l->cnt == 0,
+  but the result list is not created: the test stops with the first pair of cubes, 
+  which has a non empty intersection (and which is not removed by the xgroups).
+*/
+int bcp_IsBCLIntersectionEmpty(bcp p, bcl a, bcl b)
+{
+  bcl work = NULL;
+  int r;
+  if ( p->exclude_group_list->cnt > 0 )
+  {
+    work = bcp_NewBCL(p);
+    if ( work == NULL )
+      return -1;
+  }
+  r = bcp_intersection_bcl_loop(p, NULL, work, a, b);
+  bcp_DeleteBCL(p, work);
+  if ( r < 0 )
+    return -1;
+  return r == 0;
+}
@@ -0,0 +1,820 @@
+/*
+
+  bclirredundant.c
+
+  boolean cube list: IRREDUNDANT, remove redundant cubes with a covering problem
+
+  Boolean Cube Calculator
+  (c) 2024 Oliver Kraus
+  https://github.com/olikraus/boolean_cube
+
+  License: CC BY-SA Attribution-ShareAlike 4.0 International
+  https://creativecommons.org/licenses/by-sa/4.0/
+
+
+  Based on the IRREDUNDANT step of Espresso (R. Rudell):
+
+  1. Relatively essential cubes E: cubes, which are not covered by the rest of the list
+  2. Totally redundant cubes: redundant cubes, which are covered by E, they are removed
+  3. Partially redundant cubes Rp: all other cubes
+
+  The result is E plus a subset of Rp. The minterms of Rp, which are not covered
+  by E, are calculated with the disjoint sharp operation. A cube without such
+  minterms is totally redundant. The minterms are split into pieces (rows), which are either inside or outside of
+  each cube of Rp. Each row must be covered by one of the selected Rp cubes
+  (columns). The covering problem is solved with essential columns, a greedy
+  start solution and a branch and bound search with a node limit.
+
+  If there are too many rows, then the partially redundant cubes are removed
+  one after the other (like bcp_DoBCLMultiCubeContainment(), but without time limit).
+
+  In both cases the result is irredundant: No cube is covered by the other cubes.
+
+  bcp_DoBCLExactIrredundant() solves the covering problem exactly: more rows are
+  allowed, dominated columns are removed and the branch and bound search is only
+  limited by the resource governor. Applied to the list of all primes, the result
+  is a minimum cover (see bclexact.c).
+
+*/
+
+#include "bc.h"
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+#define BCP_IRR_MAX_ROWS 4096
+#define BCP_IRR_MAX_NODES 10000
+#define BCP_IRR_EXACT_MAX_ROWS 65536
+
+struct bcp_irr_struct
+{
+  bcp p;
+  int is_exact;                 // no node limit, the search is stopped by the governor only
+  int is_aborted;               // the governor has stopped the search
+  int max_row_cnt;              // BCP_IRR_MAX_ROWS or BCP_IRR_EXACT_MAX_ROWS
+  int col_cnt;                  // number of partially redundant cubes
+  int w;                        // number of uint64_t words for a set of columns
+  int row_cnt;
+  int row_max;
+  uint64_t *row_list;           // row_cnt sets of columns, each with w words
+  uint64_t *sel;                // currently selected columns
+  uint64_t *best;               // best solution so far
+  uint64_t *used;               // columns of the rows for the lower bound
+  uint64_t *excl;               // columns, which are excluded in the exact search
+  int best_cnt;
+  long node_cnt;
+};
+
+#define bcp_irr_GetRow(x, r) ((x)->row_list + (size_t)(r)*(x)->w)
+#define bcp_irr_IsBit(s, k) (((s)[(k)/64] >> ((k)%64)) & 1)
+#define bcp_irr_SetBit(s, k) ((s)[(k)/64] |= 1ULL << ((k)%64))
+#define bcp_irr_ClrBit(s, k) ((s)[(k)/64] &= ~(1ULL << ((k)%64)))
+
+/* returns the position of the new row or -1 for memory error, "row" can be a row of "x" */
+static int bcp_irr_add_row(struct bcp_irr_struct *x, const uint64_t *row)
+{
+  uint64_t *list;
+  if ( x->row_cnt >= x->row_max )
+  {
+    int max = x->row_max*2 + 64;
+    ptrdiff_t row_pos = -1;
+    if ( row != NULL && row >= x->row_list && row < x->row_list + (size_t)x->row_cnt*x->w )
+      row_pos = row - x->row_list;      // "row" would be invalid after realloc
+    list = (uint64_t *)realloc(x->row_list, (size_t)max*x->w*sizeof(uint64_t));
+    if ( list == NULL )
+      return -1;
+    x->row_list = list;
+    x->row_max = max;
+    if ( row_pos >= 0 )
+      row = list + row_pos;
+  }
+  if ( row == NULL )
+    memset(bcp_irr_GetRow(x, x->row_cnt), 0, x->w*sizeof(uint64_t));
+  else
+    memcpy(bcp_irr_GetRow(x, x->row_cnt), row, x->w*sizeof(uint64_t));
+  return x->row_cnt++;
+}
+
+/* returns 1 if row "r" contains at least one of the columns in "s" */
+static int bcp_irr_is_row_covered(struct bcp_irr_struct *x, int r, const uint64_t *s)
+{
+  int i;
+  const uint64_t *row = bcp_irr_GetRow(x, r);
+  for( i = 0; i < x->w; i++ )
+    if ( row[i] & s[i] )
+      return 1;
+  return 0;
+}
+
+static int bcp_irr_get_bit_cnt(struct bcp_irr_struct *x, const uint64_t *s)
+{
+  int i, cnt = 0;
+  for( i = 0; i < x->w; i++ )
+    cnt += __builtin_popcountll(s[i]);
+  return cnt;
+}
+
+/*
+  Remove cube "e" from the pieces in "t" with the disjoint sharp operation.
+  Removed pieces are marked as deleted, use bcp_PurgeBCL() afterwards.
+  returns 0 for memory error or too many pieces
+*/
+static int bcp_irr_sharp(bcp p, bcl t, bc e, int max_row_cnt)
+{
+  int i, v, cnt = t->cnt;
+  unsigned cv, ev;
+  bc c;
+  for( i = 0; i < cnt; i++ )
+  {
+    if ( t->flags[i] != 0 )
+      continue;
+    c = bcp_GetBCLCube(p, t, i);
+    if ( bcp_IsIntersectionCube(p, e, c) == 0 )
+      continue;
+    if ( bcp_IsSubsetCube(p, e, c) == 0 )
+    {
+      for( v = 0; v < p->var_cnt; v++ )
+      {
+        ev = bcp_GetCubeVar(p, e, v);
+        cv = bcp_GetCubeVar(p, c, v);
+        if ( (cv & ~ev & 3) != 0 )
+        {
+          if ( t->cnt >= max_row_cnt )
+            return 0;
+          bcp_SetCubeVar(p, c, v, cv & ~ev & 3);
+          if ( bcp_AddBCLCubeByCube(p, t, c) < 0 )
+            return 0;
+          c = bcp_GetBCLCube(p, t, i);    // the list might have been reallocated
+          bcp_SetCubeVar(p, c, v, cv & ev);
+        }
+      }
+    }
+    t->flags[i] = 1;    // the remaining part of "c" is inside of "e"
+  }
+  return 1;
+}
+
+/*
+  Split the pieces in "d" against the partially redundant cube "s" (column "k"): each
+  piece must be either inside or outside of "s". Pieces inside "s" get column "k".
+  The part outside of "s" is calculated with the disjoint sharp operation.
+  returns 0 for memory error or too many rows
+*/
+static int bcp_irr_split_rows(bcp p, struct bcp_irr_struct *x, bcl d, bc s, int k)
+{
+  int i, v, cnt = d->cnt;
+  unsigned dv, sv;
+  bc c;
+  for( i = 0; i < cnt; i++ )
+  {
+    c = bcp_GetBCLCube(p, d, i);
+    if ( bcp_IsSubsetCube(p, s, c) )
+    {
+      bcp_irr_SetBit(bcp_irr_GetRow(x, i), k);
+      continue;
+    }
+    if ( bcp_IsIntersectionCube(p, s, c) == 0 )
+      continue;
+    /* "c" is partly inside "s": append the parts outside of "s", then reduce "c" to the part inside of "s" */
+    for( v = 0; v < p->var_cnt; v++ )
+    {
+      sv = bcp_GetCubeVar(p, s, v);
+      dv = bcp_GetCubeVar(p, c, v);
+      if ( (dv & ~sv & 3) != 0 )
+      {
+        if ( d->cnt >= x->max_row_cnt )
+          return 0;
+        bcp_SetCubeVar(p, c, v, dv & ~sv & 3);
+        if ( bcp_AddBCLCubeByCube(p, d, c) < 0 || bcp_irr_add_row(x, bcp_irr_GetRow(x, i)) < 0 )
+          return 0;
+        c = bcp_GetBCLCube(p, d, i);    // the list might have been reallocated
+        bcp_SetCubeVar(p, c, v, dv & sv);
+      }
+    }
+    bcp_irr_SetBit(bcp_irr_GetRow(x, i), k);
+  }
+  return 1;
+}
+
+/* returns 1 if row "a" is a subset of row "b" */
+static int bcp_irr_is_row_subset(struct bcp_irr_struct *x, int a, int b)
+{
+  int i;
+  const uint64_t *ra = bcp_irr_GetRow(x, a);
+  const uint64_t *rb = bcp_irr_GetRow(x, b);
+  for( i = 0; i < x->w; i++ )
+    if ( (ra[i] & ~rb[i]) != 0 )
+      return 0;
+  return 1;
+}
+
+/*
+  remove rows, which contain all columns of another row: such a row is
+  covered, if the other row is covered. From equal rows only one is kept.
+*/
+static void bcp_irr_reduce_rows(struct bcp_irr_struct *x)
+{
+  int a, b, cnt = 0;
+  for( a = 0; a < x->row_cnt; a++ )
+  {
+    for( b = 0; b < cnt; b++ )
+      if ( bcp_irr_is_row_subset(x, b, a) )
+        break;
+    if ( b < cnt )
+      continue;         // "a" is covered by a kept row
+    for( b = 0; b < cnt; b++ )
+    {
+      if ( bcp_irr_is_row_subset(x, a, b) )
+      {
+        /* the kept row "b" is dominated by "a": remove it */
+        cnt--;
+        memcpy(bcp_irr_GetRow(x, b), bcp_irr_GetRow(x, cnt), x->w*sizeof(uint64_t));
+        b--;
+      }
+    }
+    memmove(bcp_irr_GetRow(x, cnt), bcp_irr_GetRow(x, a), x->w*sizeof(uint64_t));
+    cnt++;
+  }
+  x->row_cnt = cnt;
+}
+
+/*
+  lower bound for the number of additional columns: number of uncovered rows, 
+  which do not have a common column
+*/
+static int bcp_irr_get_lower_bound(struct bcp_irr_struct *x)
+{
+  int r, i, cnt = 0;
+  const uint64_t *row;
+  memset(x->used, 0, x->w*sizeof(uint64_t));
+  for( r = 0; r < x->row_cnt; r++ )
+  {
+    if ( bcp_irr_is_row_covered(x, r, x->sel) == 0 && bcp_irr_is_row_covered(x, r, x->used) == 0 )
+    {
+      row = bcp_irr_GetRow(x, r);
+      for( i = 0; i < x->w; i++ )
+        x->used[i] |= row[i];
+      cnt++;
+    }
+  }
+  return cnt;
+}
+
+/* branch and bound: cover the remaining rows with as few columns as possible */
+static void bcp_irr_solve(struct bcp_irr_struct *x, int sel_cnt)
+{
+  int r, k, bit_cnt;
+  int min_row = -1;
+  int min_bit_cnt = x->col_cnt+1;
+  uint64_t *row;
+
+  if ( sel_cnt >= x->best_cnt )
+    return;
+  for( r = 0; r < x->row_cnt; r++ )
+  {
+    if ( bcp_irr_is_row_covered(x, r, x->sel) == 0 )
+    {
+      bit_cnt = bcp_irr_get_bit_cnt(x, bcp_irr_GetRow(x, r));
+      if ( bit_cnt < min_bit_cnt )
+      {
+        min_bit_cnt = bit_cnt;
+        min_row = r;
+      }
+    }
+  }
+  if ( min_row < 0 )
+  {
+    /* all rows are covered */
+    memcpy(x->best, x->sel, x->w*sizeof(uint64_t));
+    x->best_cnt = sel_cnt;
+    return;
+  }
+  if ( sel_cnt+bcp_irr_get_lower_bound(x) >= x->best_cnt )
+    return;
+  if ( x->node_cnt++ > BCP_IRR_MAX_NODES )
+    return;             // keep the best solution so far
+  row = bcp_irr_GetRow(x, min_row);
+  for( k = 0; k < x->col_cnt; k++ )
+  {
+    if ( bcp_irr_IsBit(row, k) )
+    {
+      bcp_irr_SetBit(x->sel, k);
+      bcp_irr_solve(x, sel_cnt+1);
+      bcp_irr_ClrBit(x->sel, k);
+    }
+  }
+}
+
+/* returns the number of columns of row "r", which are not excluded */
+static int bcp_irr_get_free_bit_cnt(struct bcp_irr_struct *x, int r)
+{
+  int i, cnt = 0;
+  const uint64_t *row = bcp_irr_GetRow(x, r);
+  for( i = 0; i < x->w; i++ )
+    cnt += __builtin_popcountll(row[i] & ~x->excl[i]);
+  return cnt;
+}
+
+/*
+  lower bound for the exact search: like bcp_irr_get_lower_bound(), but excluded
+  columns are ignored. The rows are sorted by the number of columns, so that rows
+  with few columns are used first. returns -1 if a row can not be covered any more.
+*/
+static int bcp_irr_get_exact_lower_bound(struct bcp_irr_struct *x)
+{
+  int r, i, cnt = 0;
+  const uint64_t *row;
+  memset(x->used, 0, x->w*sizeof(uint64_t));
+  for( r = 0; r < x->row_cnt; r++ )
+  {
+    if ( bcp_irr_is_row_covered(x, r, x->sel) == 0 )
+    {
+      row = bcp_irr_GetRow(x, r);
+      for( i = 0; i < x->w; i++ )
+        if ( (row[i] & ~x->excl[i] & x->used[i]) != 0 )
+          break;
+      if ( i < x->w )
+        continue;
+      for( i = 0; i < x->w; i++ )
+        x->used[i] |= row[i] & ~x->excl[i];
+      if ( bcp_irr_get_free_bit_cnt(x, r) == 0 )
+        return -1;
+      cnt++;
+    }
+  }
+  return cnt;
+}
+
+/*
+  exact branch and bound: select the uncovered row with the fewest columns and
+  try each of its columns, most uncovered rows first. A column, which has been
+  tried, is excluded for the remaining siblings and their subtrees, so each
+  set of columns is visited only once. Stopped by the governor only.
+*/
+static void bcp_irr_solve_exact(struct bcp_irr_struct *x, int sel_cnt)
+{
+  int r, k, i, bit_cnt, lb;
+  int min_row = -1;
+  int min_bit_cnt = x->col_cnt+1;
+  int cand_cnt = 0;
+  int *cand_list;
+  int *cand_rows;
+  uint64_t *row;
+
+  if ( x->is_aborted || sel_cnt >= x->best_cnt )
+    return;
+  for( r = 0; r < x->row_cnt; r++ )
+  {
+    if ( bcp_irr_is_row_covered(x, r, x->sel) == 0 )
+    {
+      bit_cnt = bcp_irr_get_free_bit_cnt(x, r);
+      if ( bit_cnt < min_bit_cnt )
+      {
+        min_bit_cnt = bit_cnt;
+        min_row = r;
+      }
+    }
+  }
+  if ( min_row < 0 )
+  {
+    /* all rows are covered */
+    memcpy(x->best, x->sel, x->w*sizeof(uint64_t));
+    x->best_cnt = sel_cnt;
+    return;
+  }
+  if ( min_bit_cnt == 0 )
+    return;             // the row can not be covered with the remaining columns
+  lb = bcp_irr_get_exact_lower_bound(x);
+  if ( lb < 0 || sel_cnt+lb >= x->best_cnt )
+    return;
+  x->node_cnt++;
+  if ( bcp_CheckGovernor(x->p) == 0 )
+  {
+    x->is_aborted = 1;
+    return;
+  }
+
+  cand_list = (int *)malloc(min_bit_cnt*2*sizeof(int));
+  if ( cand_list == NULL )
+  {
+    x->is_aborted = 1;
+    return;
+  }
+  cand_rows = cand_list + min_bit_cnt;
+  row = bcp_irr_GetRow(x, min_row);
+  for( k = 0; k < x->col_cnt; k++ )
+  {
+    if ( bcp_irr_IsBit(row, k) && bcp_irr_IsBit(x->excl, k) == 0 )
+    {
+      /* number of uncovered rows of column "k", insertion sort, larger first */
+      bit_cnt = 0;
+      for( r = 0; r < x->row_cnt; r++ )
+        if ( bcp_irr_IsBit(bcp_irr_GetRow(x, r), k) && bcp_irr_is_row_covered(x, r, x->sel) == 0 )
+          bit_cnt++;
+      for( i = cand_cnt; i > 0 && cand_rows[i-1] < bit_cnt; i-- )
+      {
+        cand_list[i] = cand_list[i-1];
+        cand_rows[i] = cand_rows[i-1];
+      }
+      cand_list[i] = k;
+      cand_rows[i] = bit_cnt;
+      cand_cnt++;
+    }
+  }
+  for( i = 0; i < cand_cnt; i++ )
+  {
+    k = cand_list[i];
+    bcp_irr_SetBit(x->sel, k);
+    bcp_irr_solve_exact(x, sel_cnt+1);
+    bcp_irr_ClrBit(x->sel, k);
+    bcp_irr_SetBit(x->excl, k);
+  }
+  for( i = 0; i < cand_cnt; i++ )
+    bcp_irr_ClrBit(x->excl, cand_list[i]);
+  free(cand_list);
+}
+
+/* sort the rows by the number of columns, fewer columns first (insertion sort) */
+static int bcp_irr_sort_rows(struct bcp_irr_struct *x)
+{
+  int r, i, cnt;
+  int *cnt_list = (int *)malloc((x->row_cnt+1)*sizeof(int));
+  uint64_t *tmp = (uint64_t *)malloc(x->w*sizeof(uint64_t));
+  if ( cnt_list == NULL || tmp == NULL )
+    return free(cnt_list), free(tmp), 0;
+  for( r = 0; r < x->row_cnt; r++ )
+  {
+    memcpy(tmp, bcp_irr_GetRow(x, r), x->w*sizeof(uint64_t));
+    cnt = bcp_irr_get_bit_cnt(x, tmp);
+    for( i = r; i > 0 && cnt_list[i-1] > cnt; i-- )
+      cnt_list[i] = cnt_list[i-1];
+    memmove(bcp_irr_GetRow(x, i+1), bcp_irr_GetRow(x, i), (size_t)(r-i)*x->w*sizeof(uint64_t));
+    memcpy(bcp_irr_GetRow(x, i), tmp, x->w*sizeof(uint64_t));
+    cnt_list[i] = cnt;
+  }
+  free(tmp);
+  free(cnt_list);
+  return 1;
+}
+
+/*
+  remove columns, which are dominated by another column: all rows of the column are
+  also rows of the other column. From equal columns only the first is kept.
+  The size of a minimum cover is not changed. returns the number of removed columns
+  or -1 for memory error.
+*/
+static int bcp_irr_reduce_columns(struct bcp_irr_struct *x)
+{
+  int r, j, k, i, cnt = 0;
+  int rw = (x->row_cnt+63)/64;          // number of uint64_t words for a set of rows
+  uint64_t *col_list = (uint64_t *)calloc((size_t)x->col_cnt*rw+1, sizeof(uint64_t));
+  char *is_removed = (char *)calloc(x->col_cnt+1, 1);
+  uint64_t *ck, *cj;
+
+  if ( col_list == NULL || is_removed == NULL )
+    return free(col_list), free(is_removed), -1;
+  for( r = 0; r < x->row_cnt; r++ )
+    for( k = 0; k < x->col_cnt; k++ )
+      if ( bcp_irr_IsBit(bcp_irr_GetRow(x, r), k) )
+        bcp_irr_SetBit(col_list + (size_t)k*rw, r);
+  for( k = 0; k < x->col_cnt; k++ )
+  {
+    ck = col_list + (size_t)k*rw;
+    for( j = 0; j < x->col_cnt; j++ )
+    {
+      if ( j == k || is_removed[j] )
+        continue;
+      cj = col_list + (size_t)j*rw;
+      for( i = 0; i < rw; i++ )
+        if ( (ck[i] & ~cj[i]) != 0 )
+          break;
+      if ( i < rw )
+        continue;
+      if ( j > k )
+      {
+        /* equal columns: keep the first one */
+        for( i = 0; i < rw; i++ )
+          if ( ck[i] != cj[i] )
+            break;
+        if ( i >= rw )
+          continue;
+      }
+      is_removed[k] = 1;
+      break;
+    }
+  }
+  for( k = 0; k < x->col_cnt; k++ )
+  {
+    if ( is_removed[k] )
+    {
+      for( r = 0; r < x->row_cnt; r++ )
+        bcp_irr_ClrBit(bcp_irr_GetRow(x, r), k);
+      cnt++;
+    }
+  }
+  free(is_removed);
+  free(col_list);
+  return cnt;
+}
+
+/* remove columns from the best solution, which are not required to cover all rows */
+static void bcp_irr_remove_redundant_columns(struct bcp_irr_struct *x)
+{
+  int r, k;
+  for( k = x->col_cnt-1; k >= 0; k-- )
+  {
+    if ( bcp_irr_IsBit(x->best, k) == 0 )
+      continue;
+    bcp_irr_ClrBit(x->best, k);
+    for( r = 0; r < x->row_cnt; r++ )
+      if ( bcp_irr_is_row_covered(x, r, x->best) == 0 )
+        break;
+    if ( r < x->row_cnt )
+      bcp_irr_SetBit(x->best, k);       // column is required
+  }
+  x->best_cnt = bcp_irr_get_bit_cnt(x, x->best);
+}
+
+/*
+  calculate the start solution for bcp_irr_solve():
+  essential columns, then greedy selection, finally remove redundant columns
+*/
+static void bcp_irr_greedy(struct bcp_irr_struct *x)
+{
+  int r, k, cnt, best_k, best_cnt;
+  uint64_t *row;
+
+  memset(x->best, 0, x->w*sizeof(uint64_t));
+  for( r = 0; r < x->row_cnt; r++ )
+  {
+    row = bcp_irr_GetRow(x, r);
+    if ( bcp_irr_get_bit_cnt(x, row) == 1 )
+      for( k = 0; k < x->w; k++ )
+        x->best[k] |= row[k];
+  }
+  for(;;)
+  {
+    best_k = -1;
+    best_cnt = 0;
+    for( k = 0; k < x->col_cnt; k++ )
+    {
+      if ( bcp_irr_IsBit(x->best, k) )
+        continue;
+      cnt = 0;
+      for( r = 0; r < x->row_cnt; r++ )
+        if ( bcp_irr_IsBit(bcp_irr_GetRow(x, r), k) && bcp_irr_is_row_covered(x, r, x->best) == 0 )
+          cnt++;
+      if ( cnt > best_cnt )
+      {
+        best_cnt = cnt;
+        best_k = k;
+      }
+    }
+    if ( best_k < 0 )
+      break;
+    bcp_irr_SetBit(x->best, best_k);
+  }
+  bcp_irr_remove_redundant_columns(x);
+}
+
+/*
+  remove the totally redundant cubes and select the partially redundant cubes with the covering problem
+  "rp" contains the positions of the redundant cubes in "l", "e" contains the relatively essential cubes.
+  The totally redundant cubes are removed from "rp" and marked as deleted in "l".
+  returns 0 for memory error, too many rows or if the budget is exceeded, the partially 
+  redundant cubes are not removed in this case
+*/
+static int bcp_irr_cover(bcp p, bcl l, bcl e, int *rp, int *rp_cnt, int is_exact)
+{
+  struct bcp_irr_struct x;
+  bcl d = NULL;
+  bcl t = NULL;
+  int i, j, k;
+  int result = 0;
+
+  memset(&x, 0, sizeof(struct bcp_irr_struct));
+  x.p = p;
+  x.is_exact = is_exact;
+  x.max_row_cnt = is_exact ? BCP_IRR_EXACT_MAX_ROWS : BCP_IRR_MAX_ROWS;
+  d = bcp_NewBCL(p);
+  t = bcp_NewBCL(p);
+  if ( d == NULL || t == NULL )
+    goto done;
+
+  /* 
+    the rows start with the parts of the redundant cubes, which are not covered by "e". 
+    If there is no such part, then the cube is totally redundant.
+  */
+  for( i = 0, k = 0; i < *rp_cnt; i++ )
+  {
+    bcp_ClearBCL(p, t);
+    if ( bcp_AddBCLCubeByCube(p, t, bcp_GetBCLCube(p, l, rp[i])) < 0 )
+      break;
+    for( j = 0; j < e->cnt && t->cnt > 0; j++ )
+    {
+      if ( bcp_irr_sharp(p, t, bcp_GetBCLCube(p, e, j), x.max_row_cnt) == 0 )
+        break;
+      bcp_PurgeBCL(p, t);
+    }
+    if ( j < e->cnt && t->cnt > 0 )
+      break;
+    if ( t->cnt == 0 )
+    {
+      l->flags[rp[i]] = 1;       // totally redundant
+      continue;
+    }
+    for( j = 0; j < t->cnt; j++ )
+      if ( bcp_AddBCLCubeByCube(p, d, bcp_GetBCLCube(p, t, j)) < 0 )
+        break;
+    if ( j < t->cnt )
+      break;
+    rp[k++] = rp[i];
+  }
+  if ( i < *rp_cnt )
+  {
+    /* error: keep the remaining cubes */
+    while( i < *rp_cnt )
+      rp[k++] = rp[i++];
+    *rp_cnt = k;
+    goto done;
+  }
+  *rp_cnt = k;
+  if ( k == 0 )
+  {
+    result = 1;
+    goto done;
+  }
+  
+  x.col_cnt = k;
+  x.w = (k+63)/64;
+  x.sel = (uint64_t *)calloc(x.w, sizeof(uint64_t));
+  x.best = (uint64_t *)calloc(x.w, sizeof(uint64_t));
+  x.used = (uint64_t *)calloc(x.w, sizeof(uint64_t));
+  x.excl = (uint64_t *)calloc(x.w, sizeof(uint64_t));
+  if ( x.sel == NULL || x.best == NULL || x.used == NULL || x.excl == NULL )
+    goto done;
+  bcp_DoBCLSingleCubeContainment(p, d);
+  if ( d->cnt > x.max_row_cnt )
+    goto done;
+  for( i = 0; i < d->cnt; i++ )
+    if ( bcp_irr_add_row(&x, NULL) < 0 )
+      goto done;
+
+  for( i = 0; i < k; i++ )
+  {
+    if ( bcp_CheckGovernor(p) == 0 )
+      goto done;
+    if ( bcp_irr_split_rows(p, &x, d, bcp_GetBCLCube(p, l, rp[i]), i) == 0 )
+      goto done;
+  }
+
+  bcp_irr_reduce_rows(&x);
+  if ( is_exact )
+  {
+    /* dominance reductions, until nothing changes */
+    for(;;)
+    {
+      j = bcp_irr_reduce_columns(&x);
+      if ( j < 0 )
+        goto done;
+      if ( j == 0 )
+        break;
+      i = x.row_cnt;
+      bcp_irr_reduce_rows(&x);
+      if ( i == x.row_cnt )
+        break;
+    }
+  }
+  bcp_irr_greedy(&x);
+  if ( is_exact )
+  {
+    if ( bcp_irr_sort_rows(&x) == 0 )
+      goto done;
+    logprint(6, "bcp_DoBCLExactIrredundant, rows=%d, columns=%d, greedy=%d", x.row_cnt, x.col_cnt, x.best_cnt);
+    bcp_irr_solve_exact(&x, 0);         // if aborted, then the best solution so far is used
+  }
+  else
+  {
+    bcp_irr_solve(&x, 0);
+  }
+  bcp_irr_remove_redundant_columns(&x);         // required if the node limit was reached
+  logprint(6, "bcp_DoBCLIrredundant, rows=%d, columns=%d, selected=%d, nodes=%ld", x.row_cnt, x.col_cnt, x.best_cnt, x.node_cnt);
+
+  for( i = 0; i < k; i++ )
+    if ( bcp_irr_IsBit(x.best, i) == 0 )
+      l->flags[rp[i]] = 1;
+  result = x.is_aborted == 0;           // the cover is valid, but might not be minimal if aborted
+
+done:
+  bcp_DeleteBCL(p, t);
+  bcp_DeleteBCL(p, d);
+  free(x.row_list);
+  free(x.excl);
+  free(x.used);
+  free(x.best);
+  free(x.sel);
+  return result;
+}
+
+/*
+  remove the redundant cubes of "l", "is_exact" selects the exact covering problem.
+  returns 0 for memory error, if the budget is exceeded or (in exact mode) if the
+  covering problem is too large.
+*/
+static int bcp_do_bcl_irredundant(bcp p, bcl l, int is_exact)
+{
+  int i, j;
+  int *rp;              // positions of the partially redundant cubes, later the not essential cubes
+  int rp_cnt = 0;
+  int r_cnt = 0;
+  int e_cnt;
+  int *vcl;
+  int result = 0;
+  bcl e;
+
+  bcp_InvalidateBCLVarCnt(p, l);        // flags are modified directly
+  logprint(5, "bcp_DoBCLIrredundant start, bcl size=%d", l->cnt);
+  rp = (int *)malloc(l->cnt*sizeof(int)+1);
+  e = bcp_NewBCL(p);
+  if ( rp == NULL || e == NULL )
+  {
+    free(rp);
+    bcp_DeleteBCL(p, e);
+    logprint(1, "bcp_DoBCLIrredundant: memory error");
+    return 0;
+  }
+
+  /* relatively essential cubes */
+  for( i = 0; i < l->cnt; i++ )
+  {
+    if ( l->flags[i] == 0 )
+    {
+      if ( bcp_CheckGovernor(p) == 0 )
+        goto done;      // budget exceeded, nothing is removed
+      if ( bcp_IsBCLCubeRedundant(p, l, i) )
+        rp[r_cnt++] = i;
+      else if ( bcp_AddBCLCubeByCube(p, e, bcp_GetBCLCube(p, l, i)) < 0 )
+        goto done;
+    }
+  }
+  e_cnt = e->cnt;
+
+  /* totally and partially redundant cubes */
+  rp_cnt = r_cnt;
+  result = 1;
+  if ( rp_cnt > 0 && bcp_irr_cover(p, l, e, rp, &rp_cnt, is_exact) == 0 )
+  {
+    result = 0;
+    if ( is_exact || bcp_IsGovernorExceeded(p) )
+      goto done;
+    /* too many rows: remove the cubes one after the other, start with the smallest cubes */
+    vcl = bcp_GetBCLVarCntList(p, l);
+    if ( vcl != NULL )
+    {
+      for( i = 1; i < rp_cnt; i++ )     // insertion sort by the number of literals, larger first
+        for( j = i; j > 0 && vcl[rp[j-1]] < vcl[rp[j]]; j-- )
+        {
+          int tmp = rp[j]; rp[j] = rp[j-1]; rp[j-1] = tmp;
+        }
+      free(vcl);
+    }
+    for( i = 0; i < rp_cnt; i++ )
+    {
+      if ( bcp_CheckGovernor(p) == 0 )
+        break;
+      if ( bcp_IsBCLCubeRedundant(p, l, rp[i]) )
+        l->flags[rp[i]] = 1;
+    }
+    result = i >= rp_cnt;
+  }
+  logprint(5, "bcp_DoBCLIrredundant end, essential=%d, totally redundant=%d, partially redundant=%d", e_cnt, r_cnt-rp_cnt, rp_cnt);
+
+done:
+  bcp_PurgeBCL(p, l);
+  bcp_DeleteBCL(p, e);
+  free(rp);
+  return result;
+}
+
+/*
+  IRREDUNDANT
+
+  Remove cubes from "l", which are covered by the rest of the list "l". The
+  result is irredundant, unless the budget is exceeded (see bcgovernor.c).
+*/
+void bcp_DoBCLIrredundant(bcp p, bcl l)
+{
+  bcp_do_bcl_irredundant(p, l, 0);
+}
+
+/*
+  Select a minimum number of cubes from "l", which still cover the same function.
+  returns 0 for memory error, if the budget is exceeded or if the covering problem
+  is too large. "l" is still a valid cover in this case: if the budget is exceeded
+  during the search, then the best cover so far is used, otherwise "l" might be redundant.
+*/
+int bcp_DoBCLExactIrredundant(bcp p, bcl l)
+{
+  return bcp_do_bcl_irredundant(p, l, 1);
+}
@@ -33,11 +33,13 @@ void bcp_MinimizeBCLWithOffSet(bcp p, bcl l)
   logprint(2, "bcp_MinimizeBCLWithOffSet, initial bcl size=%d", l->cnt );
   bcp_DoBCLSingleCubeContainment(p, l);         // do an initial SCC simplification
   complement = bcp_NewBCLComplementWithSubtract(p, l);      // calculate the complement for the expand algo
-  assert( complement != NULL );
-  bcp_DoBCLExpandWithOffSet(p, l, complement);          // expand all terms as far es possible
-  bcp_DeleteBCL(p, complement);
-  bcp_DoBCLSingleCubeContainment(p, l);                         // do another SCC as a preparation for the MCC
-  bcp_DoBCLMultiCubeContainment(p, l);                          // finally do multi cube minimization
+  if ( complement != NULL )     // NULL if the budget is exceeded, see bcgovernor.c
+  {
+    bcp_DoBCLExpandWithOffSet(p, l, complement);          // expand all terms as far es possible
+    bcp_DeleteBCL(p, complement);
+  }
+  bcp_DoBCLSingleCubeContainment(p, l);                         // do another SCC as a preparation for the IRREDUNDANT step
+  bcp_DoBCLIrredundant(p, l);                                   // finally remove the redundant cubes
   logprint(2, "bcp_MinimizeBCLWithOffSet, result bcl size=%d", l->cnt );
 }
 
@@ -47,8 +49,8 @@ void bcp_MinimizeBCLWithOnSet(bcp p, bcl l)
   logprint(2, "bcp_MinimizeBCLWithOnSet, initial bcl size=%d", l->cnt );
   bcp_DoBCLSingleCubeContainment(p, l);         // do an initial SCC simplification
   bcp_DoBCLExpandWithCofactor(p, l);          // expand all terms as far es possible
-  bcp_DoBCLSingleCubeContainment(p, l);                         // do another SCC as a preparation for the MCC
-  bcp_DoBCLMultiCubeContainment(p, l);                          // finally do multi cube minimization
+  bcp_DoBCLSingleCubeContainment(p, l);                         // do another SCC as a preparation for the IRREDUNDANT step
+  bcp_DoBCLIrredundant(p, l);                                   // finally remove the redundant cubes
   logprint(2, "bcp_MinimizeBCLWithOnSet, result bcl size=%d", l->cnt );
 }
 
@@ -58,7 +60,14 @@ void bcp_MinimizeBCLWithSubtract(bcp p, bcl l)
   bcl result;
   logprint(2, "bcp_MinimizeBCLWithSubtract, initial bcl size=%d", l->cnt );
   off_set = bcp_NewBCLComplementWithSubtract(p, l); // includes bcp_DoBCLMultiCubeContainment
+  if ( off_set == NULL )
+    return;             // memory error or budget exceeded, keep "l"
   result = bcp_NewBCLComplementWithSubtract(p, off_set); // includes bcp_DoBCLMultiCubeContainment
+  if ( result == NULL )
+  {
+    bcp_DeleteBCL(p, off_set);
+    return;
+  }
   bcp_CopyBCL(p, l, result);
   bcp_DeleteBCL(p, off_set);
   bcp_DeleteBCL(p, result);
@@ -67,9 +76,36 @@ void bcp_MinimizeBCLWithSubtract(bcp p, bcl l)
 
 void bcp_MinimizeBCL(bcp p, bcl l)
 {
-  bcp_MinimizeBCLWithOnSet(p, l);
+  struct bcp_result_cache_struct key;
+  struct bcp_result_cache_struct *e;
+  int is_espresso = p->minimize_mode == BCP_MINIMIZE_MODE_ESPRESSO;
+  int is_exact = p->minimize_mode == BCP_MINIMIZE_MODE_EXACT;
+  int is_key = bcp_GetResultCacheKey(p, &key, is_exact ? BCP_RESULT_CACHE_EXACT : is_espresso ? BCP_RESULT_CACHE_ESPRESSO : BCP_RESULT_CACHE_MINIMIZE, l, NULL);       // bclcache.c
+  p->espresso_stat.iteration_cnt = 0;
+  p->is_minimize_exact = 0;
+  if ( is_key && (e = bcp_FindResultCache(p, &key)) != NULL )
+  {
+    if ( bcp_CopyBCL(p, l, e->result) != 0 )
+    {
+      p->is_minimize_exact = is_exact;  // only exact results are cached for the exact mode
+      p->espresso_stat.iteration_cnt = -1;      // no iterations for a cached result, "espressoStats" is not reported
+      return;
+    }
+  }
+  if ( is_exact )
+  {
+    p->is_minimize_exact = bcp_MinimizeBCLExact(p, l);     // bclexact.c
+    if ( p->is_minimize_exact == 0 )
+      is_key = 0;       // don't cache the heuristic result
+  }
+  else if ( is_espresso )
+    bcp_MinimizeBCLWithEspresso(p, l);  // bclespresso.c
+  else
+    bcp_MinimizeBCLWithOnSet(p, l);
   // bcp_MinimizeBCLWithOffSet(p, l);
   //bcp_MinimizeBCLWithSubtract(p, l);
+  if ( is_key )
+    bcp_AddResultCacheBCL(p, &key, l);       // ignore memory errors, the result is just not cached
 }
 
 
@@ -0,0 +1,168 @@
+/*
+
+  bclspill.c
+
+  boolean cube list: out of core storage for large lists
+
+  Boolean Cube Calculator
+  (c) 2024 Oliver Kraus
+  https://github.com/olikraus/boolean_cube
+
+  License: CC BY-SA Attribution-ShareAlike 4.0 International
+  https://creativecommons.org/licenses/by-sa/4.0/
+
+
+  The subtract and the intersection can create intermediate lists with
+  millions of cubes. If a list reaches p->spill_cnt cubes, then the cubes
+  are moved from the heap into a shared memory map of a temporary file.
+  The kernel can write these pages back to the file and drop them, instead
+  of swapping anonymous memory. The flags (one byte per cube) stay on the heap.
+
+  The temporary file is created in p->spill_dir (or $TMPDIR or /tmp) and is
+  removed immediately, so it disappears with the last close.
+  If the file can not be created, bcp_ResizeBCLList() fails like a memory error.
+
+  p->spill_cnt = 0 disables the spill mode (default).
+
+  All cube memory of a list is allocated with bcp_ResizeBCLList() and
+  released with bcp_FreeBCLList(), see bclcore.c. The bcl_struct members
+  "list" and "max" have the same meaning for both storage types.
+  bcp_ResizeBCLList() also resizes the flags, so l->max is never larger
+  than the flags array.
+
+*/
+
+#include "bc.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+
+static int bcp_open_spill_file(bcp p)
+{
+  char name[1024];
+  const char *dir = p->spill_dir;
+  int fd;
+  if ( dir == NULL )
+    dir = getenv("TMPDIR");
+  if ( dir == NULL )
+    dir = "/tmp";
+  snprintf(name, sizeof(name), "%s/bcspillXXXXXX", dir);
+  fd = mkstemp(name);
+  if ( fd < 0 )
+    return -1;
+  unlink(name);         // the file is removed with the last close
+  return fd;
+}
+
+/* map "max" cubes of the spill file of "l", the file must already have the required size, returns NULL for error */
+static __m128i *bcp_map_spill_file(bcp p, bcl l, int max)
+{
+  void *ptr = mmap(NULL, (size_t)max*p->bytes_per_cube_cnt, PROT_READ|PROT_WRITE, MAP_SHARED, l->spill_fd, 0);
+  if ( ptr == MAP_FAILED )
+    return NULL;
+  return (__m128i *)ptr;
+}
+
+/* resize the flags of "l" for "max" cubes, the flags are resized before the cubes, returns 0 for memory error */
+static int bcp_resize_bcl_flags(bcl l, int max)
+{
+  uint8_t *flags = (uint8_t *)realloc(l->flags, (size_t)max*sizeof(uint8_t)+1);
+  if ( flags == NULL )
+    return 0;
+  l->flags = flags;
+  return 1;
+}
+
+/*
+  resize the cube memory and the flags of "l" for at least "max" cubes.
+  The content is preserved, l->list, l->flags and l->max are updated.
+  returns 0 for memory error, l->max is not changed in this case
+*/
+int bcp_ResizeBCLList(bcp p, bcl l, int max)
+{
+  __m128i *list;
+  int new_max;
+
+  if ( l->spill_fd < 0 && (p->spill_cnt <= 0 || max < p->spill_cnt) )
+  {
+    if ( bcp_resize_bcl_flags(l, max) == 0 )
+      return 0;
+    list = (__m128i *)realloc(l->list, (size_t)max*p->bytes_per_cube_cnt);
+    if ( list == NULL )
+      return 0;
+    l->list = list;
+    l->max = max;
+    return 1;
+  }
+
+  if ( max <= l->max && l->spill_fd >= 0 )
+    return 1;
+  new_max = l->max*2 > max ? l->max*2 : max;    // grow geometrically, each step requires a new map
+  if ( bcp_resize_bcl_flags(l, new_max) == 0 )
+    return 0;
+
+  if ( l->spill_fd < 0 )
+  {
+    /* move the cubes from the heap into the file */
+    l->spill_fd = bcp_open_spill_file(p);
+    if ( l->spill_fd < 0 )
+    {
+      logprint(1, "spill: can not create a temporary file in '%s'", p->spill_dir == NULL ? "$TMPDIR or /tmp" : p->spill_dir);
+      return 0;
+    }
+    list = NULL;
+    if ( ftruncate(l->spill_fd, (off_t)new_max*p->bytes_per_cube_cnt) == 0 )
+      list = bcp_map_spill_file(p, l, new_max);
+    if ( list == NULL )
+    {
+      close(l->spill_fd);
+      l->spill_fd = -1;
+      return 0;
+    }
+    if ( l->list != NULL )
+      memcpy(list, l->list, (size_t)l->cnt*p->bytes_per_cube_cnt);
+    free(l->list);
+    l->list = list;
+    l->max = new_max;
+    p->spill_list_cnt++;
+    logprint(3, "spill: list with %d cubes moved to a temporary file", l->cnt);
+    return 1;
+  }
+
+  /* extend the file, the content of the old map is already in the file */
+  if ( ftruncate(l->spill_fd, (off_t)new_max*p->bytes_per_cube_cnt) != 0 )
+    return 0;
+  list = bcp_map_spill_file(p, l, new_max);
+  if ( list == NULL )
+    return 0;           // the old map is still valid
+  munmap(l->list, (size_t)l->max*p->bytes_per_cube_cnt);
+  l->list = list;
+  l->max = new_max;
+  return 1;
+}
+
+/* release the cube memory of "l" */
+void bcp_FreeBCLList(bcp p, bcl l)
+{
+  if ( l->spill_fd >= 0 )
+  {
+    if ( l->list != NULL )
+      munmap(l->list, (size_t)l->max*p->bytes_per_cube_cnt);
+    close(l->spill_fd);
+    l->spill_fd = -1;
+  }
+  else
+  {
+    free(l->list);
+  }
+  l->list = NULL;
+  l->max = 0;
+}
+
+/* returns 1 if the cubes of "l" are stored in a temporary file */
+int bcp_IsBCLSpilled(bcp p, bcl l)
+{
+  return l->spill_fd >= 0;
+}
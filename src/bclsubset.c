@@ -40,6 +40,12 @@
 int bcp_IsBCLSubsetWithCofactor(bcp p, bcl a, bcl b)
 {
   int i;
+  /* the counterexamples of previous cover tests might refute any of the cubes, check them before the first tautology test */
+  for( i = 0; i < b->cnt; i++ )
+  {
+    if ( bcp_IsBCLCubeRefutedByCache(p, a, bcp_GetBCLCube(p, b, i)) )    // bclcontainment.c
+      return 0;
+  }
   for( i = 0; i < b->cnt; i++ )
   {
     if ( bcp_IsBCLCubeCovered(p, a, bcp_GetBCLCube(p, b, i)) == 0 )     // bclcontainment.c
@@ -50,7 +56,16 @@ int bcp_IsBCLSubsetWithCofactor(bcp p, bcl a, bcl b)
 
 int bcp_IsBCLSubset(bcp p, bcl a, bcl b)
 {
-  return bcp_IsBCLSubsetWithCofactor(p, a, b);
+  struct bcp_result_cache_struct key;
+  struct bcp_result_cache_struct *e;
+  int result;
+  int is_key = bcp_GetResultCacheKey(p, &key, BCP_RESULT_CACHE_SUBSET, a, b);   // bclcache.c
+  if ( is_key && (e = bcp_FindResultCache(p, &key)) != NULL )
+    return e->value;
+  result = bcp_IsBCLSubsetWithCofactor(p, a, b);
+  if ( is_key )
+    bcp_AddResultCacheValue(p, &key, result);       // ignore memory errors, the result is just not cached
+  return result;
 }
 
 /*
@@ -30,6 +30,8 @@
 */
 
 #include "bc.h"
+#include <stdlib.h>
+#include <string.h>
 #include <assert.h>
 
 /*
@@ -67,41 +69,349 @@ static int bcp_DoBCLSharpOperation(bcp p, bcl l, bc a, bc b)
   return 1; // success
 }
 
+/*
+  Disjoint sharp: subtract cube b from a: a#b and append the result to l.
+  The appended cubes do not intersect with each other: each new cube gets the
+  values of b for the variables which have been used for the previous cubes.
+  "a" is modified by this procedure.
+*/
+static int bcp_DoBCLDisjointSharpOperation(bcp p, bcl l, bc a, bc b)
+{
+  int i;
+  unsigned bb;
+  unsigned orig_aa;
+  unsigned new_aa;
+
+  if ( bcp_IsIntersectionCube(p, a, b) == 0 )
+    return bcp_AddBCLCubeByCube(p, l, a) < 0 ? 0 : 1;     // a#b = a
+  for( i = 0; i < p->var_cnt; i++ )
+  {
+    bb = bcp_GetCubeVar(p, b, i);
+    if ( bb != 3 )
+    {
+      orig_aa = bcp_GetCubeVar(p, a, i); 
+      new_aa = orig_aa & (bb^3);
+      if ( new_aa != 0 )
+      {
+        bcp_SetCubeVar(p, a, i, new_aa);
+        if ( bcp_AddBCLCubeByCube(p, l, a) < 0 )
+          return 0;  // memory error
+        bcp_SetCubeVar(p, a, i, orig_aa & bb);     // not zero, because a and b intersect
+      }
+    }
+  }
+  return 1; // success
+}
+
+/*=================================================================*/
+/* order of the subtrahend cubes */
+
+/*
+  The size of the intermediate result depends on the order of the cubes of "b".
+  p->subtract_order selects the order:
+    BCP_SUBTRACT_ORDER_LIST: cubes are processed in the order of the list
+    BCP_SUBTRACT_ORDER_LITERALS: cubes with more literals first, they remove less from "a"
+    BCP_SUBTRACT_ORDER_OVERLAP: cubes, which intersect with more cubes of "a", first
+    BCP_SUBTRACT_ORDER_GREEDY: in each step the cube with the smallest predicted growth,
+      the prediction is the number of cubes created by the sharp operation minus the
+      number of removed cubes
+*/
+
+static const char *bcp_subtract_order_names[] = { "list", "literals", "overlap", "greedy", NULL };
+
+int bcp_GetSubtractOrderByName(const char *name)
+{
+  int i;
+  for( i = 0; bcp_subtract_order_names[i] != NULL; i++ )
+    if ( strcmp(bcp_subtract_order_names[i], name) == 0 )
+      return i;
+  return -1;
+}
+
+/* returns the number of cubes created by a#b minus one (the removed cube a), returns 0 if a and b do not intersect */
+static int bcp_get_sharp_growth(bcp p, bc a, bc b)
+{
+  int i, h;
+  int cnt = 0;
+  uint64_t t;
+  if ( bcp_IsIntersectionCube(p, a, b) == 0 )
+    return 0;
+  for( i = 0; i < p->blk_cnt; i++ )
+  {
+    for( h = 0; h < 2; h++ )
+    {
+      t = ((uint64_t *)(a+i))[h] & ~((uint64_t *)(b+i))[h];        // nonzero for each variable, which creates a new cube
+      cnt += __builtin_popcountll((t | (t >> 1)) & 0x5555555555555555ULL);
+    }
+  }
+  return cnt - 1;
+}
+
+static int bcp_get_subtract_order_key(bcp p, bcl a, bc b, int order)
+{
+  int j, key = 0;
+  if ( order == BCP_SUBTRACT_ORDER_LITERALS )
+    return bcp_GetCubeVariableCount(p, b);
+  if ( order == BCP_SUBTRACT_ORDER_OVERLAP )
+  {
+    for( j = 0; j < a->cnt; j++ )
+      if ( a->flags[j] == 0 && bcp_IsIntersectionCube(p, bcp_GetBCLCube(p, a, j), b) )
+        key++;
+    return key;
+  }
+  /* BCP_SUBTRACT_ORDER_GREEDY: smallest growth first */
+  for( j = 0; j < a->cnt; j++ )
+    if ( a->flags[j] == 0 )
+      key -= bcp_get_sharp_growth(p, bcp_GetBCLCube(p, a, j), b);
+  return key;
+}
+
+/*
+  select the cube of "b" for the next step: 
+  order_list[pos..b->cnt-1] contains the positions of the remaining cubes of "b",
+  the cube with the largest key is moved to order_list[pos].
+  For BCP_SUBTRACT_ORDER_LITERALS and BCP_SUBTRACT_ORDER_OVERLAP the keys are calculated 
+  only once (key_list), for BCP_SUBTRACT_ORDER_GREEDY the key is calculated for each step.
+*/
+static void bcp_select_subtract_cube(bcp p, bcl a, bcl b, int *order_list, int *key_list, int pos, int order)
+{
+  int k, best = pos;
+  int t;
+  if ( order == BCP_SUBTRACT_ORDER_LIST )
+    return;
+  for( k = pos; k < b->cnt; k++ )
+  {
+    if ( order == BCP_SUBTRACT_ORDER_GREEDY || pos == 0 )
+      key_list[order_list[k]] = bcp_get_subtract_order_key(p, a, bcp_GetBCLCube(p, b, order_list[k]), order);
+    if ( key_list[order_list[k]] > key_list[order_list[best]] )
+      best = k;
+  }
+  t = order_list[pos];
+  order_list[pos] = order_list[best];
+  order_list[best] = t;
+}
+
+/* store the size and the duration of the step in p->subtract_stat, returns 0 for memory error */
+static int bcp_add_subtract_stat(bcp p, int cnt, clock_t step_clock)
+{
+  struct bcp_subtract_stat_struct *st = &(p->subtract_stat);
+  void *ptr;
+  if ( cnt > st->peak_cnt )
+    st->peak_cnt = cnt;
+  if ( st->is_record )
+  {
+    if ( st->step_cnt >= st->list_max )
+    {
+      st->list_max = st->list_max*2 + 16;
+      if ( (ptr = realloc(st->size_list, st->list_max*sizeof(int))) == NULL ) return 0;
+      st->size_list = (int *)ptr;
+      if ( (ptr = realloc(st->clock_list, st->list_max*sizeof(clock_t))) == NULL ) return 0;
+      st->clock_list = (clock_t *)ptr;
+    }
+    st->size_list[st->step_cnt] = cnt;
+    st->clock_list[st->step_cnt] = step_clock;
+  }
+  st->step_cnt++;
+  return 1;
+}
+
+/*=================================================================*/
+
+/*
+  append the new cubes of "result" to "a" and clear "result".
+  A new cube is a subset of the cube of "a", from which it was created. Because there is
+  no containment between the cubes of "a", the remaining cubes of "a" can not be a subset of 
+  a new cube: only the new cubes have to be checked against each other and against "a".
+  
+  If the sharp results of one step are added in more than one chunk (spill mode), then
+  the cubes from "first_new" to the end of "a" are the new cubes of the previous chunks.
+  These cubes can be a subset of a new cube of the current chunk (merge).
+  returns 0 for memory error
+*/
+static int bcp_add_subtract_result(bcp p, bcl a, bcl result, int first_new, int *deleted_cnt)
+{
+  int j, k;
+  bci x;
+  bc c;
+  
+  bcp_DoBCLSingleCubeContainment(p, result);
+  if ( (long)result->cnt*(a->cnt - *deleted_cnt) >= BCP_SUBTRACT_INDEX_MIN_CNT )
+  {
+    /* mark the new cubes, which are inside a remaining cube of "a", with the index of the new cubes (bclindex.c) */
+    x = bcp_NewBCI(p, result);
+    if ( x == NULL )
+      return 0;
+    for( j = 0; j < a->cnt; j++ )
+      if ( a->flags[j] == 0 )
+        bcp_DoBCISubsetCubeMark(p, x, result, bcp_GetBCLCube(p, a, j), -1);
+    if ( first_new < a->cnt )
+    {
+      /* merge: remove the cubes of the previous chunks, which are inside a new cube */
+      for( j = first_new; j < a->cnt; j++ )
+      {
+        if ( a->flags[j] == 0 && bcp_FindBCISupersetCube(p, x, result, bcp_GetBCLCube(p, a, j), -1) >= 0 )
+        {
+          a->flags[j] = 1;
+          (*deleted_cnt)++;
+        }
+      }
+    }
+    bcp_DeleteBCI(p, x);
+  }
+  else
+  {
+    for( k = 0; k < result->cnt; k++ )
+    {
+      c = bcp_GetBCLCube(p, result, k);
+      for( j = 0; j < a->cnt; j++ )
+      {
+        if ( a->flags[j] == 0 && bcp_IsSubsetCube(p, bcp_GetBCLCube(p, a, j), c) )
+        {
+          result->flags[k] = 1;
+          break;
+        }
+      }
+      if ( result->flags[k] == 0 )
+      {
+        for( j = first_new; j < a->cnt; j++ )
+        {
+          if ( a->flags[j] == 0 && bcp_IsSubsetCube(p, c, bcp_GetBCLCube(p, a, j)) )
+          {
+            a->flags[j] = 1;
+            (*deleted_cnt)++;
+          }
+        }
+      }
+    }
+  }
+  if ( bcp_AddBCLCubesByBCL(p, a, result) == 0 )    // only the cubes without flag are appended
+    return 0;
+  bcp_ClearBCL(p, result);
+  return 1;
+}
+
+/*
+  one step of the subtract: a = a - b for a single cube b. "result" is a work list.
+  "*deleted_cnt" is the number of cubes in "a", which are marked as deleted.
+  
+  In spill mode (p->spill_cnt > 0, see bclspill.c) the sharp results are added to "a" 
+  whenever "result" reaches p->spill_cnt cubes, so that only "a" becomes large.
+  returns 0 for memory error
+*/
+static int bcp_do_bcl_subtract_step(bcp p, bcl a, bc b, bcl result, int is_mcc, int *deleted_cnt)
+{
+  int j;
+  int removed_cnt = 0;
+  int cnt = a->cnt;     // "a" grows, if the result is added in chunks
+  
+  bcp_ClearBCL(p, result);
+  if ( is_mcc & BCP_SUBTRACT_DISJOINT )
+  {
+    for( j = 0; j < a->cnt; j++ )
+      if ( bcp_DoBCLDisjointSharpOperation(p, result, bcp_GetBCLCube(p, a, j), b) == 0 )
+        return 0;
+    return bcp_CopyBCL(p, a, result);
+  }
+  
+  /* 
+    only the cubes of "a", which intersect with the cube of "b" are replaced by the sharp result,
+    all other cubes stay in place: the removed cubes are marked as deleted and the new cubes 
+    are appended
+  */
+  for( j = 0; j < cnt; j++ )
+  {
+    if ( a->flags[j] == 0 && bcp_IsIntersectionCube(p, bcp_GetBCLCube(p, a, j), b) )
+    {
+      if ( bcp_DoBCLSharpOperation(p, result, bcp_GetBCLCube(p, a, j), b) == 0 )
+        return 0;
+      a->flags[j] = 1;
+      removed_cnt++;
+      (*deleted_cnt)++;
+      if ( p->spill_cnt > 0 && result->cnt >= p->spill_cnt )
+        if ( bcp_add_subtract_result(p, a, result, cnt, deleted_cnt) == 0 )
+          return 0;
+    }
+  }
+  if ( removed_cnt == 0 )
+    return 1;         // "a" is unchanged
+  if ( bcp_add_subtract_result(p, a, result, cnt, deleted_cnt) == 0 )
+    return 0;
+  bcp_InvalidateBCLVarCnt(p, a);
+  /* remove the deleted cubes, if they are the majority or if the MCC will purge the list anyway */
+  if ( 2*(*deleted_cnt) > a->cnt || (is_mcc & BCP_SUBTRACT_MCC) )
+  {
+    bcp_PurgeBCL(p, a);
+    *deleted_cnt = 0;
+  }
+  if ( is_mcc & BCP_SUBTRACT_MCC )
+    bcp_DoBCLMultiCubeContainment(p, a);
+  //bcp_MinimizeBCLWithOnSet(p, a);
+  return 1;
+}
+
 /* 
   a = a - b 
-  is_mcc: whether to execute multi cube containment or not
+  is_mcc: BCP_SUBTRACT_MCC (1): whether to execute multi cube containment or not
   if is_mcc is 0, then the substract operation will generate all prime cubes.
   if b is unate, then executing mcc slows down the substract, otherwise if b is binate, then using mcc increases performance
+  
+  is_mcc: BCP_SUBTRACT_DISJOINT (2): use the disjoint sharp operation. If the cubes of "a" do not 
+  intersect with each other (e.g. a single cube), then also the result will have this property.
+  SCC and MCC are not required in this case and are not executed. The cubes will not be primes.
+  Use bcp_GetBCLMintermCount() to get the size of the result.
+  
+  The cubes of b are processed in the order given by p->subtract_order (see above).
+  The number of cubes after each step is available in p->subtract_stat.
 */
-clock_t bcp_SubtractBCL_total = 0;
+__thread clock_t bcp_SubtractBCL_total = 0;      // only used for logging, thread local for bcc -batch
 int bcp_SubtractBCL(bcp p, bcl a, bcl b, int is_mcc)
 {
   clock_t start = clock();
   clock_t end;
-  int i, j;
-  bcl result = bcp_NewBCL(p);
-  if ( result == NULL )
-    return 0;
+  clock_t step_start;
+  int i;
+  int deleted_cnt = 0;  // number of cubes in "a" with flag set
+  int order = p->subtract_order;
+  int *order_list;      // positions of the cubes of "b" in the order of processing
+  int *key_list;
+  bcl result;
+  
+  p->subtract_stat.step_cnt = 0;
+  p->subtract_stat.peak_cnt = a->cnt;
+  p->subtract_stat.total_clock = bcp_GetMonotonicClock();
+  
+  result = bcp_NewBCL(p);
+  order_list = (int *)malloc(b->cnt*sizeof(int)+1);
+  key_list = (int *)malloc(b->cnt*sizeof(int)+1);
+  if ( result == NULL || order_list == NULL || key_list == NULL )
+    return bcp_DeleteBCL(p, result), free(order_list), free(key_list), 0;
+  for( i = 0; i < b->cnt; i++ )
+    order_list[i] = i;
 
-  logprint(2, "bcp_SubtractBCL start, var_cnt=%d, bcl a size=%d, bcl b size=%d, is_mcc=%d", p->var_cnt, a->cnt, b->cnt, is_mcc );
+  logprint(2, "bcp_SubtractBCL start, var_cnt=%d, bcl a size=%d, bcl b size=%d, is_mcc=%d, order=%d", p->var_cnt, a->cnt, b->cnt, is_mcc, order );
+  
+  if ( (is_mcc & BCP_SUBTRACT_DISJOINT) == 0 && b->cnt > 0 )
+    bcp_DoBCLSingleCubeContainment(p, a);       // required for the incremental containment in bcp_do_bcl_subtract_step()
   
   for( i = 0; i < b->cnt; i++ )
   {
-    bcp_ClearBCL(p, result);
-    for( j = 0; j < a->cnt; j++ )
-    {
-      if ( bcp_DoBCLSharpOperation(p, result, bcp_GetBCLCube(p, a, j), bcp_GetBCLCube(p, b, i)) == 0 )
-        return bcp_DeleteBCL(p, result), 0;
-    }
-    if ( bcp_CopyBCL(p, a, result) == 0 )
-        return bcp_DeleteBCL(p, result), 0;
-    bcp_DoBCLSingleCubeContainment(p, a);
-    if ( is_mcc )
-      bcp_DoBCLMultiCubeContainment(p, a);
-    //bcp_MinimizeBCLWithOnSet(p, a);
-    logprint(6, "bcp_SubtractBCL, step %d/%d, bcl result size=%d", i+1, b->cnt, a->cnt);
+    if ( bcp_CheckGovernor(p) == 0 )
+      break;       // budget exceeded, "a" is incomplete
+    step_start = bcp_GetMonotonicClock();
+    bcp_select_subtract_cube(p, a, b, order_list, key_list, i, order);
+    if ( bcp_do_bcl_subtract_step(p, a, bcp_GetBCLCube(p, b, order_list[i]), result, is_mcc, &deleted_cnt) == 0 )
+      break;
+    if ( bcp_add_subtract_stat(p, a->cnt - deleted_cnt, bcp_GetMonotonicClock() - step_start) == 0 )
+      break;
+    logprint(6, "bcp_SubtractBCL, step %d/%d, bcl result size=%d", i+1, b->cnt, a->cnt - deleted_cnt);
   }
+  bcp_PurgeBCL(p, a);
   bcp_DeleteBCL(p, result);
+  free(order_list);
+  free(key_list);
+  p->subtract_stat.total_clock = bcp_GetMonotonicClock() - p->subtract_stat.total_clock;
+  if ( i < b->cnt )
+    return 0;   // memory error or budget exceeded
   end = clock();
   bcp_SubtractBCL_total += end-start;
   logprint(2, "bcp_SubtractBCL end, bcl a size=%d, clock=%ld total=%ld", a->cnt, end-start,  bcp_SubtractBCL_total);
@@ -65,85 +65,174 @@ uint32_t rc_crc32(uint32_t crc, const char *buf, size_t len) // rosetta code
 }
 
 
-int bc_var_stack[1000];
-int bc_is_2nd[1000];
+__thread int bc_var_stack[1000];     // thread local for bcc -batch
+__thread int bc_is_2nd[1000];
 #endif // BC_TAUT_DEBUG
 
 
+/*============================================================*/
+/*
+  partition of a cube list into independent components
+
+  Two cubes are connected if they share a variable (which is not don't care in
+  both cubes). A component is a set of cubes, which do not share any variable
+  with the cubes of the other components. A union-find over the variables
+  calculates all components with one pass over the cubes: All variables of 
+  a cube are joined with the first variable of the cube.
+
+  The work area p->taut_part_list contains:
+    var_cnt entries: union-find parent of each variable
+    var_cnt entries: component index of a root variable (-1 if not assigned)
+    cnt entries: component index for each cube
+    cnt entries: number of cubes for each component
+    2*cnt entries: used by bcp_get_rows_partition() to reorder the rows
+*/
+
+/* ensure that the work area is large enough for "cnt" cubes, returns 0 for memory error */
+static int bcp_reserve_taut_part(bcp p, int cnt)
+{
+  int *list;
+  int max = 2*p->var_cnt + 4*cnt;
+  if ( max <= p->taut_part_max )
+    return 1;
+  max += max/2;
+  list = (int *)realloc(p->taut_part_list, max*sizeof(int));
+  if ( list == NULL )
+    return 0;
+  p->taut_part_list = list;
+  p->taut_part_max = max;
+  return 1;
+}
+
+static int bcp_uf_find(int *parent, int v)
+{
+  while( parent[v] != v )
+  {
+    parent[v] = parent[parent[v]];      // path halving
+    v = parent[v];
+  }
+  return v;
+}
+
+/* 
+  visit all variables of cube "c", which are not don't care: 
+  mode 0: init the union-find for each variable
+  mode 1: join all variables with the first variable
+  returns the first variable or -1 if all variables are don't care
+*/
+static int bcp_visit_cube_vars(bcp p, bc c, int *parent, int *comp, int mode)
+{
+  int b, i, v, r;
+  int first = -1;
+  uint64_t w;
+  __m128i m55 = _mm_set1_epi8(0x55);
+  __m128i x;
+  
+  for( b = 0; b < p->blk_cnt; b++ )
+  {
+    x = _mm_loadu_si128(c+b);
+    x = _mm_andnot_si128(_mm_and_si128(x, _mm_srli_epi16(x, 1)), m55);   // 01 for each variable, which is not don't care
+    for( i = 0; i < 2; i++ )
+    {
+      w = (uint64_t)_mm_cvtsi128_si64(i == 0 ? x : _mm_unpackhi_epi64(x, x));
+      while( w != 0 )
+      {
+        v = b*64 + i*32 + __builtin_ctzll(w)/2;
+        w &= w-1;
+        if ( mode == 0 )
+        {
+          parent[v] = v;
+          comp[v] = -1;
+        }
+        else if ( first < 0 )
+        {
+          first = v;
+        }
+        else
+        {
+          r = bcp_uf_find(parent, v);
+          parent[r] = bcp_uf_find(parent, first);
+        }
+      }
+    }
+  }
+  return first;
+}
+
+/*
+  calculate the components of the cubes (either the "rows" or, if rows is NULL, the cubes of "l").
+  The component index of each cube and the size of each component is stored in the work area, 
+  the component of the first cube has index 0. A cube without any variable forms a component of its own.
+  returns the number of components or -1 for memory error
+*/
+static int bcp_calc_components(bcp p, bcl l, bc *rows, int cnt)
+{
+  int *parent, *comp, *row_comp, *comp_size;
+  int i, v, k = 0;
+  
+  if ( bcp_reserve_taut_part(p, cnt) == 0 )
+    return -1;
+  parent = p->taut_part_list;
+  comp = parent + p->var_cnt;
+  row_comp = comp + p->var_cnt;
+  comp_size = row_comp + cnt;
+  
+  for( i = 0; i < cnt; i++ )
+    bcp_visit_cube_vars(p, rows != NULL ? rows[i] : bcp_GetBCLCube(p, l, i), parent, comp, 0);
+  for( i = 0; i < cnt; i++ )
+    row_comp[i] = bcp_visit_cube_vars(p, rows != NULL ? rows[i] : bcp_GetBCLCube(p, l, i), parent, comp, 1);
+  
+  for( i = 0; i < cnt; i++ )
+  {
+    v = row_comp[i];
+    if ( v >= 0 )
+    {
+      v = bcp_uf_find(parent, v);
+      if ( comp[v] < 0 )
+      {
+        comp[v] = k;
+        comp_size[k++] = 0;
+      }
+      v = comp[v];
+    }
+    else
+    {
+      v = k;
+      comp_size[k++] = 0;
+    }
+    row_comp[i] = v;
+    comp_size[v]++;
+  }
+  return k;
+}
+
 /*
   try to find independent partitions in BCL, for example
   0---
   11--
   --01
   would contain two idependent problems: 11--/0--- and on the other side --01.
-  the partition will be written into the flags array, which means, that the flags array must be all 0 entries
+  The cubes, which are not connected with the first cube, are marked with 1 in the flags array, 
+  which means, that the flags array must be all 0 entries.
+  returns 1 if a partition has been found
 */
 int bcp_is_bcl_partition(bcp p, bcl l)
 {
   int cnt = l->cnt;
   int i;
-  int other_partition_cnt = 0;
-  bc mask; // the current parition cube
-  bc mask2; // the other parition cube
-  unsigned bitcnt; // == variable count
-  unsigned nbitcnt; // == variable count
-  int is_changed;
+  int *row_comp;
   if ( cnt <= 1 )
     return 0;           // no partition if   there is only one entry
   assert(l->flags[0] == 0);
-  bcp_StartCubeStackFrame(p);  
-  mask = bcp_GetTempCube(p);
-  mask2 = bcp_GetTempCube(p);
-  
-  // take the first cube in the list as a starting point
-  
-  bcp_GetVariableMask(p, mask, bcp_GetBCLCube(p, l, 0));
-  bitcnt = bcp_OrBitCnt(p, mask, mask, mask);
-  
-  // in the first step, try to see, how much variables are reached
-  
-  do
-  {
-    // printf("mask = %s\n", bcp_GetStringFromCube(p, mask));
-    // printf("bitcnt = %u\n", bitcnt);
-    is_changed = 0;
-    for( i = 1; i < cnt; i++ )
-    {
-      bcp_GetVariableMask(p, mask2, bcp_GetBCLCube(p, l, i));
-      if ( bcp_IsAndZero(p, mask, mask2) == 0 )  // only if there is a connection between the variables
-      {
-        nbitcnt = bcp_OrBitCnt(p, mask, mask, mask2);
-        if ( bitcnt < nbitcnt  )
-        {
-          bitcnt = nbitcnt;
-          is_changed = 1;
-        }
-      }
-    }
-  } while( is_changed != 0 );
-  
-  // now mask contains a bit for each variable which is connected with each other. Try find two partitions with this
-  
+  if ( bcp_calc_components(p, l, NULL, cnt) <= 1 )
+    return 0;
+  row_comp = p->taut_part_list + 2*p->var_cnt;
   for( i = 1; i < cnt; i++ )
   {
     assert(l->flags[i] == 0);           // we need to assume here, that the flag is unussed so far, because it will be used to mark the partion
-    bcp_GetVariableMask(p, mask2, bcp_GetBCLCube(p, l, i));
-    if ( bcp_IsAndZero(p, mask, mask2) )
-    {
-      other_partition_cnt++;            // partition found
+    if ( row_comp[i] != 0 )
       l->flags[i] = 1;
-    }
   }
-  
-  if ( other_partition_cnt == 0 )
-    return bcp_EndCubeStackFrame(p), 0;         // no partition found
-  
-  // at this point the two partions marked in the flag
-  // for one partion all flags are zero, for the other parition the flags are 1
-
-  bcp_EndCubeStackFrame(p);  
-  //printf("Partition %d/%d\n", other_partition_cnt, l->cnt);
-  //bcp_ShowBCL(p, l);
   return 1;
 }
 
@@ -164,11 +253,197 @@ bcl bcp_NewBCLByFlag(bcp p, bcl l, uint8_t flag)
 }
 
 
+/*============================================================*/
+/*
+  tautology memo cache
+
+  The same cofactors appear several times during a tautology test and also
+  in the sequence of bcp_IsBCLCubeRedundant() calls of the MCC. The result of
+  the tautology test is stored in a cache, which is part of the bcp structure.
+  
+  The key is a fingerprint of the purged list: The hash values of all cubes are
+  added up, so the fingerprint does not depend on the order of the cubes.
+  Two independent 64 bit sums plus the number of cubes are compared, which 
+  makes a false match practically impossible.
+
+  The cache has a fixed size (p->taut_cache_size). A key can be stored in a small 
+  window of entries. If the window is full, then an entry is replaced by the 
+  clock algorithm (an entry with a reference bit gets a second chance).
+*/
+
+#define BCP_TAUT_CACHE_WAYS 4
+
+static void bcp_add_cube_fingerprint(bcp p, bc c, uint64_t *fp1, uint64_t *fp2)
+{
+  uint64_t h = bcp_GetCubeHash(p, c);
+  *fp1 += h;
+  h ^= h >> 31;
+  h *= 0x94d049bb133111ebULL;
+  h ^= h >> 29;
+  *fp2 += h;
+}
+
+/* fingerprint of the cubes of "l", which are not deleted, returns the number of these cubes, see also bclcache.c */
+int bcp_GetBCLFingerprint(bcp p, bcl l, uint64_t *fp1, uint64_t *fp2)
+{
+  int i, cnt = l->cnt;
+  int fp_cnt = 0;
+  *fp1 = 0;
+  *fp2 = 0;
+  for( i = 0; i < cnt; i++ )
+  {
+    if ( l->flags[i] == 0 )
+    {
+      bcp_add_cube_fingerprint(p, bcp_GetBCLCube(p, l, i), fp1, fp2);
+      fp_cnt++;
+    }
+  }
+  return fp_cnt;
+}
+
+static void bcp_get_rows_fingerprint(bcp p, bc *rows, int cnt, uint64_t *fp1, uint64_t *fp2)
+{
+  int i;
+  *fp1 = 0;
+  *fp2 = 0;
+  for( i = 0; i < cnt; i++ )
+    bcp_add_cube_fingerprint(p, rows[i], fp1, fp2);
+}
+
+/* remove all entries from the cache */
+void bcp_ClearTautologyCache(bcp p)
+{
+  if ( p->taut_cache != NULL )
+    memset(p->taut_cache, 0, sizeof(struct bcp_taut_cache_struct)*p->taut_cache_alloc_size);
+}
+
+/*
+  allocate the cache according to p->taut_cache_size, returns 0 if the cache is disabled.
+  A disabled cache is released, so that p->taut_cache is NULL.
+*/
+static int bcp_prepare_taut_cache(bcp p)
+{
+  int size = BCP_TAUT_CACHE_WAYS;
+  if ( p->taut_cache_size > 0 )
+  {
+    while( size < p->taut_cache_size )
+      size *= 2;
+    if ( p->taut_cache != NULL && p->taut_cache_alloc_size == size )
+      return 1;
+  }
+  free(p->taut_cache);
+  free(p->taut_cache_minterm_list);
+  p->taut_cache = NULL;
+  p->taut_cache_minterm_list = NULL;
+  p->taut_cache_alloc_size = 0;
+  if ( p->taut_cache_size <= 0 )
+    return 0;
+  p->taut_cache = (struct bcp_taut_cache_struct *)calloc(size, sizeof(struct bcp_taut_cache_struct));
+  if ( p->taut_cache == NULL )
+    return 0;
+  p->taut_cache_alloc_size = size;
+  return 1;
+}
+
+/* returns the cache entry for the list or NULL if the list is not in the cache */
+static struct bcp_taut_cache_struct *bcp_find_taut_cache(bcp p, uint64_t fp1, uint64_t fp2, int cnt)
+{
+  int i;
+  struct bcp_taut_cache_struct *e = p->taut_cache + ((unsigned)fp1 & (unsigned)(p->taut_cache_alloc_size-BCP_TAUT_CACHE_WAYS));
+  for( i = 0; i < BCP_TAUT_CACHE_WAYS; i++ )
+  {
+    if ( e[i].is_used && e[i].fp1 == fp1 && e[i].fp2 == fp2 && e[i].cnt == cnt )
+    {
+      e[i].is_ref = 1;
+      p->taut_cache_hit_cnt++;
+      return e+i;
+    }
+  }
+  p->taut_cache_miss_cnt++;
+  return NULL;
+}
+
+/*
+  store the result in the cache. An existing entry for the same list is updated.
+  If p->taut_minterm is not NULL, then it is stored together with a non-tautology result.
+*/
+static void bcp_add_taut_cache(bcp p, uint64_t fp1, uint64_t fp2, int cnt, int is_tautology)
+{
+  int i;
+  unsigned set = (unsigned)fp1 & (unsigned)(p->taut_cache_alloc_size-BCP_TAUT_CACHE_WAYS);
+  struct bcp_taut_cache_struct *e = p->taut_cache + set;
+  for( i = 0; i < BCP_TAUT_CACHE_WAYS; i++ )
+    if ( e[i].is_used != 0 && e[i].fp1 == fp1 && e[i].fp2 == fp2 && e[i].cnt == cnt )
+      break;
+  if ( i >= BCP_TAUT_CACHE_WAYS )
+  {
+    for( i = 0; i < BCP_TAUT_CACHE_WAYS; i++ )
+      if ( e[i].is_used == 0 )
+        break;
+  }
+  if ( i >= BCP_TAUT_CACHE_WAYS )
+  {
+    /* window is full: clock algorithm, clear the reference bits until an unreferenced entry is found */
+    for(;;)
+    {
+      i = p->taut_cache_hand % BCP_TAUT_CACHE_WAYS;
+      p->taut_cache_hand++;
+      if ( e[i].is_ref == 0 )
+        break;
+      e[i].is_ref = 0;
+    }
+  }
+  e[i].fp1 = fp1;
+  e[i].fp2 = fp2;
+  e[i].cnt = cnt;
+  e[i].is_used = 1;
+  e[i].is_ref = 0;
+  e[i].is_tautology = is_tautology;
+  e[i].is_minterm = 0;
+  if ( is_tautology == 0 && p->taut_minterm != NULL )
+  {
+    if ( p->taut_cache_minterm_list == NULL )
+      p->taut_cache_minterm_list = (__m128i *)malloc((size_t)p->taut_cache_alloc_size*p->bytes_per_cube_cnt);
+    if ( p->taut_cache_minterm_list != NULL )
+    {
+      bcp_CopyCube(p, p->taut_cache_minterm_list + (size_t)(set+i)*p->blk_cnt, p->taut_minterm);
+      e[i].is_minterm = 1;
+    }
+  }
+}
+
+/* 
+  copy the values of all variables, which are used in the rows, from the cached minterm "m" 
+  to p->taut_minterm. Other variables of "m" might belong to a different part of the recursion.
+*/
+static void bcp_copy_rows_minterm(bcp p, bc *rows, int cnt, bc m)
+{
+  int i, j;
+  __m128i lit, r;
+  __m128i m55 = _mm_set1_epi8(0x55);
+  for( i = 0; i < p->blk_cnt; i++ )
+  {
+    lit = _mm_setzero_si128();
+    for( j = 0; j < cnt; j++ )
+    {
+      r = _mm_loadu_si128(rows[j]+i);
+      lit = _mm_or_si128(lit, _mm_andnot_si128(_mm_and_si128(r, _mm_srli_epi16(r, 1)), m55));    // 01 for each variable, which is not don't care
+    }
+    lit = _mm_or_si128(lit, _mm_slli_epi16(lit, 1));
+    _mm_storeu_si128(p->taut_minterm+i, 
+      _mm_or_si128(_mm_andnot_si128(lit, _mm_loadu_si128(p->taut_minterm+i)), _mm_and_si128(lit, _mm_loadu_si128(m+i))));
+  }
+}
+
+/*============================================================*/
+
+int bcp_IsBCLTautologySub(bcp p, bcl l, int depth, int is_2nd);
+
 // the unate check is faster than the split var calculation, but if the BCL is binate, 
 // then both calculations have to be done
 // so the unate precheck does not improve performance soo much (maybe 5%)
 //#define BCL_TAUTOLOGY_WITH_UNATE_PRECHECK
-int bcp_IsBCLTautologySub(bcp p, bcl l, int depth, int is_2nd)
+static int bcp_IsBCLTautologyCalc(bcp p, bcl l, int depth, int is_2nd)
 {
   int var_pos;
   bcl f1;
@@ -180,6 +455,8 @@ int bcp_IsBCLTautologySub(bcp p, bcl l, int depth, int is_2nd)
   
   assert(depth < 1000);
   
+  if ( bcp_CheckGovernor(p) == 0 )
+    return 0;           // budget exceeded, conservative result
   if ( l->cnt == 0 )
     return 0;
   
@@ -224,7 +501,7 @@ int bcp_IsBCLTautologySub(bcp p, bcl l, int depth, int is_2nd)
   // however bcp_IsBCLUnate() is much faster then bcp_GetBCLMaxBinateSplitVariable()
   
 #ifdef BCL_TAUTOLOGY_WITH_UNATE_PRECHECK  
-  is_unate = bcp_IsBCLUnate(p);
+  is_unate = bcp_IsBCLUnate(p, l);
   if ( is_unate )
   {
     int i, cnt = l->cnt;
@@ -306,7 +583,613 @@ int bcp_IsBCLTautologySub(bcp p, bcl l, int depth, int is_2nd)
   return bcp_DeleteBCL(p,  f1), bcp_DeleteBCL(p,  f2), 1;
 }
 
+/*
+  check the memo cache, then calculate the tautology property with bcp_IsBCLTautologyCalc()
+  small lists are not cached, the fingerprint calculation would be more expensive than the tautology test
+*/
+int bcp_IsBCLTautologySub(bcp p, bcl l, int depth, int is_2nd)
+{
+  uint64_t fp1, fp2;
+  struct bcp_taut_cache_struct *e;
+  int fp_cnt;
+  int result;
+  
+  if ( p->taut_cache == NULL || l->cnt < p->taut_cache_min_cnt )
+    return bcp_IsBCLTautologyCalc(p, l, depth, is_2nd);
+  
+  fp_cnt = bcp_GetBCLFingerprint(p, l, &fp1, &fp2);
+  e = bcp_find_taut_cache(p, fp1, fp2, fp_cnt);
+  if ( e != NULL )
+    return e->is_tautology;
+  result = bcp_IsBCLTautologyCalc(p, l, depth, is_2nd);
+  if ( bcp_IsGovernorExceeded(p) == 0 )      // don't store the conservative result
+    bcp_add_taut_cache(p, fp1, fp2, fp_cnt, result);
+  return result;
+}
+
+int bcp_IsBCLTautologyWithCopy(bcp p, bcl l)
+{
+  int result;
+  bcp_prepare_taut_cache(p);
+  bcp_InvalidateBCLVarCnt(p, l);        // the caller might have modified the cubes directly
+  result = bcp_IsBCLTautologySub(p, l, 0, 0);
+  bcp_InvalidateBCLVarCnt(p, l);        // don't keep the table for the caller, see above
+  return result;
+}
+
+/*============================================================*/
+/*
+  in-place tautology test
+
+  bcp_IsBCLTautologySub() creates two new lists for each split. The following 
+  procedures work on an array of cube pointers ("rows", p->taut_row_list) instead.
+  A subproblem is a segment of this array. For a cofactor, a new segment with
+  the remaining rows is created on top of the array and the split variable is
+  set to don't care directly inside the cubes. The modified cubes are recorded 
+  in an undo segment and restored after the subproblem is solved. 
+  This means: No cube is copied and the row array is only extended if required.
+  
+  Containment is done lazily: Only while the segment for a cofactor is created,
+  rows which are covered by one of the modified cubes are not taken over.
+  The segment for the second cofactor is created only if the first cofactor
+  is a tautology.
+*/
+
+/* ensure that "cnt" more rows can be added to p->taut_row_list, returns 0 for memory error */
+static int bcp_reserve_taut_rows(bcp p, int cnt)
+{
+  bc *list;
+  int max;
+  if ( p->taut_row_cnt + cnt <= p->taut_row_max )
+    return 1;
+  max = p->taut_row_max*2;
+  if ( max < p->taut_row_cnt + cnt )
+    max = p->taut_row_cnt + cnt + 256;
+  list = (bc *)realloc(p->taut_row_list, max*sizeof(bc));
+  if ( list == NULL )
+    return 0;
+  p->taut_row_list = list;
+  p->taut_row_max = max;
+  return 1;
+}
+
+/*
+  column statistics of the rows (see bccofactor.c) are stored in p->taut_var_cnt_list.
+  Each subproblem, which requires the statistics, allocates one slot on top of this stack.
+  ensure that "cnt" more slots can be used, returns 0 for memory error 
+*/
+static int bcp_reserve_taut_var_cnt(bcp p, int cnt)
+{
+  uint32_t *list;
+  int max;
+  if ( p->taut_var_cnt_cnt + cnt <= p->taut_var_cnt_max )
+    return 1;
+  max = p->taut_var_cnt_max*2 + cnt + 8;
+  list = (uint32_t *)realloc(p->taut_var_cnt_list, (size_t)max*bcp_GetVarCntListSize(p)*sizeof(uint32_t));
+  if ( list == NULL )
+    return 0;
+  p->taut_var_cnt_list = list;
+  p->taut_var_cnt_max = max;
+  return 1;
+}
+
+#define bcp_get_taut_var_cnt(p, slot) ((p)->taut_var_cnt_list + (size_t)(slot)*bcp_GetVarCntListSize(p))
+
+/*
+  rows version of bcp_is_bcl_partition(): 
+  reorder the rows of the segment, so that the rows of each component are next to each other,
+  smallest component first. The number of rows of each part is stored in "part_list".
+  If there are more than "part_max" components, then the largest components are merged
+  into the last part.
+  returns the number of parts (1 if there is no partition or for memory error)
+*/
+static int bcp_get_rows_partition(bcp p, int pos, int cnt, int *part_list, int part_max)
+{
+  int i, j, k, n, t;
+  int *row_comp, *comp_size, *order, *comp_start;
+  bc *rows, *tmp;
+  
+  if ( cnt <= 1 )
+    return 1;
+  k = bcp_calc_components(p, NULL, p->taut_row_list + pos, cnt);
+  if ( k <= 1 )
+    return 1;
+  if ( bcp_reserve_taut_rows(p, cnt) == 0 )
+    return 1;
+  rows = p->taut_row_list + pos;
+  tmp = p->taut_row_list + p->taut_row_cnt;
+  row_comp = p->taut_part_list + 2*p->var_cnt;
+  comp_size = row_comp + cnt;
+  
+  order = comp_size + cnt;
+  comp_start = order + cnt;
+  
+  /* sort the components by size (insertion sort, usually there are only a few components) */
+  for( i = 0; i < k; i++ )
+  {
+    t = i;
+    for( j = i; j > 0 && comp_size[order[j-1]] > comp_size[t]; j-- )
+      order[j] = order[j-1];
+    order[j] = t;
+  }
+  
+  /* calculate the start position of each component and the size of each part */
+  n = 0;
+  for( i = 0; i < k; i++ )
+  {
+    t = order[i];
+    comp_start[t] = n;
+    n += comp_size[t];
+    if ( i < part_max )
+      part_list[i] = comp_size[t];
+    else
+      part_list[part_max-1] += comp_size[t];
+  }
+  
+  /* move the rows to their new position */
+  for( i = 0; i < cnt; i++ )
+    tmp[comp_start[row_comp[i]]++] = rows[i];
+  memcpy(rows, tmp, cnt*sizeof(bc));
+  return k < part_max ? k : part_max;
+}
+
+/*============================================================*/
+/*
+  truth table evaluation
+
+  If the rows of a subproblem depend only on a few variables (the support of the 
+  rows), then a truth table with one bit per minterm of the support is faster 
+  than the recursion. Each row sets the bits of its minterms and the rows are a 
+  tautology if all bits are set.
+
+  One block (__m128i) of the table covers the first 7 support variables,
+  the remaining support variables select the block. A row is added to all
+  blocks which match the literals of the row for the upper support variables.
+*/
+
+#define BCP_TAUT_TT_BLK_MAX (1<<(BCP_TAUT_TT_MAX_VAR_CNT-7))
+
+/*
+  collect the variables which are not don't care in at least one of the rows.
+  returns the number of variables or -1 if there are more than "max" variables
+*/
+static int bcp_get_rows_support(bcp p, bc *rows, int cnt, int *var_list, int max)
+{
+  int i, b;
+  int var_cnt = 0;
+  uint64_t w;
+  __m128i m55 = _mm_set1_epi8(0x55);
+  __m128i acc, c;
+  
+  for( b = 0; b < p->blk_cnt; b++ )
+  {
+    acc = _mm_setzero_si128();
+    for( i = 0; i < cnt; i++ )
+    {
+      c = _mm_loadu_si128(rows[i]+b);
+      acc = _mm_or_si128(acc, _mm_andnot_si128(_mm_and_si128(c, _mm_srli_epi16(c, 1)), m55));    // 01 for each variable with 01, 10 (or 00)
+    }
+    for( i = 0; i < 2; i++ )
+    {
+      w = (uint64_t)_mm_cvtsi128_si64(i == 0 ? acc : _mm_unpackhi_epi64(acc, acc));
+      while( w != 0 )
+      {
+        if ( var_cnt >= max )
+          return -1;
+        var_list[var_cnt++] = b*64 + i*32 + __builtin_ctzll(w)/2;
+        w &= w-1;
+      }
+    }
+  }
+  return var_cnt;
+}
+
+/* the minterms of the first 7 variables within a block */
+static __m128i bcp_get_tt_var_block(int i)
+{
+  static const uint64_t m[6] = {
+    0xaaaaaaaaaaaaaaaaULL, 0xccccccccccccccccULL, 0xf0f0f0f0f0f0f0f0ULL,
+    0xff00ff00ff00ff00ULL, 0xffff0000ffff0000ULL, 0xffffffff00000000ULL };
+  if ( i < 6 )
+    return _mm_set_epi64x((long long)m[i], (long long)m[i]);
+  return _mm_set_epi64x(-1LL, 0LL);
+}
+
+/* 
+  cost model: decide whether the truth table is faster than the recursion.
+  Measured with random lists (bench with 6..16 variables and 4..1024 cubes): 
+  Up to 14 variables the truth table was always faster (factor 2 to 25). 
+  For 15 and 16 variables the recursion may win, because each row with only
+  a few literals has to be added to many blocks, so limit the number of block 
+  operations there.
+*/
+#define BCP_TAUT_TT_ALWAYS_VAR_CNT 14
+#define BCP_TAUT_TT_MAX_BLK_OP_CNT 32768L
+static int bcp_is_taut_rows_tt_useful(int cnt, int var_cnt)
+{
+  if ( var_cnt <= BCP_TAUT_TT_ALWAYS_VAR_CNT )
+    return 1;
+  return ((long)cnt << (var_cnt-7)) <= BCP_TAUT_TT_MAX_BLK_OP_CNT;
+}
+
+/* tautology test with a truth table, var_cnt must not be larger than BCP_TAUT_TT_MAX_VAR_CNT */
+static int bcp_is_taut_rows_tt(bcp p, bc *rows, int cnt, const int *var_list, int var_cnt)
+{
+  __m128i tt[BCP_TAUT_TT_BLK_MAX];
+  __m128i var_blk[7];
+  __m128i m;
+  int blk_cnt = var_cnt > 7 ? 1 << (var_cnt-7) : 1;
+  int i, j;
+  unsigned v, fix, val, free, sub;
+  
+  assert( var_cnt <= BCP_TAUT_TT_MAX_VAR_CNT );
+  for( i = 0; i < 7; i++ )
+    var_blk[i] = bcp_get_tt_var_block(i);
+  memset(tt, 0, blk_cnt*sizeof(__m128i));
+  
+  for( j = 0; j < cnt; j++ )
+  {
+    m = _mm_set1_epi8(-1);
+    fix = 0;
+    val = 0;
+    for( i = 0; i < var_cnt; i++ )
+    {
+      v = bcp_GetCubeVar(p, rows[j], var_list[i]);
+      if ( v == 3 )
+        continue;
+      if ( v == 0 )
+        break;          // illegal cube, does not contain any minterm
+      if ( i < 7 )
+        m = v == 2 ? _mm_and_si128(m, var_blk[i]) : _mm_andnot_si128(var_blk[i], m);
+      else
+      {
+        fix |= 1u << (i-7);
+        if ( v == 2 )
+          val |= 1u << (i-7);
+      }
+    }
+    if ( i < var_cnt )
+      continue;
+    /* OR the block into all blocks which match the literals of the upper variables */
+    free = (unsigned)(blk_cnt-1) & ~fix;
+    sub = 0;
+    do
+    {
+      tt[val|sub] = _mm_or_si128(tt[val|sub], m);
+      sub = (sub - free) & free;
+    } while( sub != 0 );
+  }
+  
+  /* 
+    all bits must be set. If var_cnt is below 7, then the unused bits of the block
+    belong to variables which are don't care in all rows, so they are set together with the used bits
+  */
+  m = tt[0];
+  for( i = 1; i < blk_cnt; i++ )
+    m = _mm_and_si128(m, tt[i]);
+  if ( _mm_movemask_epi8(_mm_cmpeq_epi8(m, _mm_set1_epi8(-1))) == 0xffff )
+    return 1;
+  
+  if ( p->taut_minterm != NULL )
+  {
+    /* decode the first zero bit of the truth table into the values of the support variables */
+    for( j = 0; j < blk_cnt; j++ )
+    {
+      v = (~_mm_movemask_epi8(_mm_cmpeq_epi8(tt[j], _mm_set1_epi8(-1)))) & 0xffff;
+      if ( v != 0 )
+        break;
+    }
+    assert( j < blk_cnt );
+    i = __builtin_ctz(v);                                       // byte with a zero bit
+    sub = (unsigned)i*8 + __builtin_ctz(~((uint8_t *)(tt+j))[i] & 0xff);  // bit position within the block
+    for( i = 0; i < var_cnt; i++ )
+    {
+      val = i < 7 ? (sub >> i) & 1 : ((unsigned)j >> (i-7)) & 1;
+      bcp_SetCubeVar(p, p->taut_minterm, var_list[i], val + 1);
+    }
+  }
+  return 0;
+}
+
+/*
+  assign the opposite value of the literals of the rows to the minterm, so that none of the
+  rows contains the minterm. Requires a unate list (or a single row), variables with both 
+  literals are not changed.
+*/
+static void bcp_set_rows_minterm(bcp p, bc *rows, int cnt)
+{
+  int i, j;
+  __m128i acc, both, mask;
+  __m128i m55 = _mm_set1_epi8(0x55);
+  
+  for( i = 0; i < p->blk_cnt; i++ )
+  {
+    /* 10 for a zero literal, 01 for a one literal: this is the opposite value of the literal */
+    acc = _mm_setzero_si128();
+    for( j = 0; j < cnt; j++ )
+      acc = _mm_or_si128(acc, _mm_andnot_si128(_mm_loadu_si128(rows[j]+i), _mm_set1_epi8(-1)));
+    both = _mm_and_si128(_mm_and_si128(acc, _mm_srli_epi16(acc, 1)), m55);
+    acc = _mm_andnot_si128(_mm_or_si128(both, _mm_slli_epi16(both, 1)), acc);
+    mask = _mm_and_si128(_mm_or_si128(acc, _mm_srli_epi16(acc, 1)), m55);
+    mask = _mm_or_si128(mask, _mm_slli_epi16(mask, 1));
+    _mm_storeu_si128(p->taut_minterm+i, _mm_or_si128(_mm_andnot_si128(mask, _mm_loadu_si128(p->taut_minterm+i)), acc));
+  }
+}
+
+/*============================================================*/
+
+/* the bcp_is_taut_rows procedures return 1 for a tautology, 0 if not a tautology and -1 for memory error */
+static int bcp_is_taut_rows(bcp p, int pos, int cnt, int depth, int slot);
+
+/*
+  check the cofactor of the segment at "pos" for the variable at "var_pos".
+  value 1: cofactor for var=0, keep rows with zero or don't care
+  value 2: cofactor for var=1, keep rows with one or don't care
+*/
+static int bcp_is_taut_rows_cofactor(bcp p, int pos, int cnt, int var_pos, unsigned value, int depth, int slot)
+{
+  bc *rows;
+  bc *undo;
+  bc *view;
+  bc *drop;
+  bc c;
+  int i, k;
+  int undo_pos = p->taut_row_cnt;
+  int undo_cnt = 0;
+  int view_cnt = 0;
+  int drop_cnt = 0;
+  int child_slot = -1;
+  uint32_t *var_cnt_list;
+  unsigned v;
+  int result;
+  
+  if ( bcp_reserve_taut_rows(p, 3*cnt) == 0 )
+    return -1;          // memory error
+  rows = p->taut_row_list + pos;
+  undo = p->taut_row_list + undo_pos;
+  
+  /* step 1: set the variable to don't care in all rows with the "value" and record these rows in the undo segment */
+  for( i = 0; i < cnt; i++ )
+  {
+    if ( bcp_GetCubeVar(p, rows[i], var_pos) == value )
+    {
+      bcp_SetCubeVar(p, rows[i], var_pos, 3);
+      undo[undo_cnt++] = rows[i];
+    }
+  }
+  
+  /* step 2: create the segment for the cofactor, drop rows which are covered by a modified cube */
+  view = undo + undo_cnt;
+  drop = view + cnt;            // dropped rows are collected behind the largest possible cofactor segment
+  for( i = 0; i < cnt; i++ )
+  {
+    c = rows[i];
+    v = bcp_GetCubeVar(p, c, var_pos);
+    if ( v == 3 )
+    {
+      for( k = 0; k < undo_cnt; k++ )
+      {
+        if ( undo[k] != c && bcp_IsSubsetCube(p, undo[k], c) )
+        {
+          /* "c" is covered by undo[k], for equal cubes keep the first one */
+          if ( bcp_IsSubsetCube(p, c, undo[k]) == 0 || undo[k] < c )
+            break;
+        }
+      }
+      if ( k >= undo_cnt )
+        view[view_cnt++] = c;
+      else
+        drop[drop_cnt++] = c;
+    }
+    else
+    {
+      drop[drop_cnt++] = c;
+    }
+  }
+  
+  /* 
+    step 3: derive the column statistics of the cofactor from the statistics of this node,
+    if this is cheaper than counting the cofactor rows
+  */
+  if ( slot >= 0 && undo_cnt + drop_cnt < view_cnt && bcp_reserve_taut_var_cnt(p, 1) != 0 )
+  {
+    child_slot = p->taut_var_cnt_cnt++;
+    var_cnt_list = bcp_get_taut_var_cnt(p, child_slot);
+    memcpy(var_cnt_list, bcp_get_taut_var_cnt(p, slot), bcp_GetVarCntListSize(p)*sizeof(uint32_t));
+    if ( value == 1 )
+      var_cnt_list[bcp_GetVarCntZeroPos(p, var_pos)] -= undo_cnt;       // the zero literals have been removed
+    else
+      var_cnt_list[bcp_GetVarCntOnePos(p, var_pos)] -= undo_cnt;        // the one literals have been removed
+    for( i = 0; i < drop_cnt; i++ )
+      bcp_AddCubeVarCnt(p, drop[i], var_cnt_list, -1);
+  }
+  
+  p->taut_row_cnt = undo_pos + undo_cnt + view_cnt;
+  result = bcp_is_taut_rows(p, undo_pos + undo_cnt, view_cnt, depth+1, child_slot);
+  if ( child_slot >= 0 )
+    p->taut_var_cnt_cnt--;
+  if ( result == 0 && p->taut_minterm != NULL )
+    bcp_SetCubeVar(p, p->taut_minterm, var_pos, value);       // the cofactor is not a tautology for this value
+  
+  /* step 4: undo the changes, the row array might have been moved by realloc */
+  undo = p->taut_row_list + undo_pos;
+  for( k = 0; k < undo_cnt; k++ )
+    bcp_SetCubeVar(p, undo[k], var_pos, value);
+  p->taut_row_cnt = undo_pos;
+  return result;
+}
+
+#define BCP_TAUT_PART_MAX 32
+static int bcp_is_taut_rows_split(bcp p, int pos, int cnt, int depth, int slot)
+{
+  bc *rows = p->taut_row_list + pos;
+  int i;
+  int var_pos;
+  int result;
+  
+  var_pos = bcp_GetMaxBinateSplitVariableByVarCnt(p, bcp_get_taut_var_cnt(p, slot));
+  if ( var_pos < 0 )
+  {
+    // unate list: tautology only if the list contains the tautology cube
+    for( i = 0; i < cnt; i++ )
+      if ( bcp_IsTautologyCube(p, rows[i]) )
+        return 1;
+    if ( p->taut_minterm != NULL )
+      bcp_set_rows_minterm(p, rows, cnt);
+    return 0;
+  }
+  
+  result = bcp_is_taut_rows_cofactor(p, pos, cnt, var_pos, 1, depth, slot);
+  if ( result <= 0 )
+    return result;      // not a tautology or memory error
+  return bcp_is_taut_rows_cofactor(p, pos, cnt, var_pos, 2, depth, slot);
+}
+
+/* 
+  "slot" is the position of the column statistics for the rows in p->taut_var_cnt_list 
+  or -1 if the statistics are not yet calculated 
+*/
+static int bcp_is_taut_rows_calc(bcp p, int pos, int cnt, int depth, int slot)
+{
+  int part_list[BCP_TAUT_PART_MAX];
+  int i, k;
+  int result;
+  
+  k = bcp_get_rows_partition(p, pos, cnt, part_list, BCP_TAUT_PART_MAX);
+  if ( k > 1 )
+  {
+    // if one of the partitions is a tautology, then the complete list is a tautology
+    // the smallest partitions are checked first, because they are the cheapest
+    for( i = 0; i < k; i++ )
+    {
+      result = bcp_is_taut_rows(p, pos, part_list[i], depth+1, -1);
+      if ( result != 0 )
+        return result;  // tautology or memory error
+      pos += part_list[i];
+    }
+    return 0;
+  }
+  
+  if ( slot >= 0 )
+    return bcp_is_taut_rows_split(p, pos, cnt, depth, slot);
+  
+  if ( bcp_reserve_taut_var_cnt(p, 1) == 0 )
+    return -1;          // memory error
+  slot = p->taut_var_cnt_cnt++;
+  bcp_CalcRowsVarCnt(p, p->taut_row_list + pos, cnt, bcp_get_taut_var_cnt(p, slot));
+  result = bcp_is_taut_rows_split(p, pos, cnt, depth, slot);
+  p->taut_var_cnt_cnt--;
+  return result;
+}
+
+static int bcp_is_taut_rows(bcp p, int pos, int cnt, int depth, int slot)
+{
+  uint64_t fp1, fp2;
+  struct bcp_taut_cache_struct *e;
+  int var_list[BCP_TAUT_TT_MAX_VAR_CNT];
+  int var_cnt;
+  int result;
+  
+  assert(depth < 1000);
+  if ( bcp_CheckGovernor(p) == 0 )
+    return 0;           // budget exceeded, conservative result
+  if ( cnt == 0 )
+    return 0;
+  if ( cnt == 1 )
+  {
+    if ( bcp_IsTautologyCube(p, p->taut_row_list[pos]) )
+      return 1;
+    if ( p->taut_minterm != NULL )
+      bcp_set_rows_minterm(p, p->taut_row_list + pos, 1);
+    return 0;
+  }
+  
+  if ( p->taut_tt_max_var_cnt > 0 )
+  {
+    var_cnt = bcp_get_rows_support(p, p->taut_row_list + pos, cnt, var_list, 
+      p->taut_tt_max_var_cnt < BCP_TAUT_TT_MAX_VAR_CNT ? p->taut_tt_max_var_cnt : BCP_TAUT_TT_MAX_VAR_CNT);
+    if ( var_cnt >= 0 && bcp_is_taut_rows_tt_useful(cnt, var_cnt) )
+      return bcp_is_taut_rows_tt(p, p->taut_row_list + pos, cnt, var_list, var_cnt);
+  }
+  
+  if ( p->taut_cache == NULL || cnt < p->taut_cache_min_cnt )
+    return bcp_is_taut_rows_calc(p, pos, cnt, depth, slot);
+
+  bcp_get_rows_fingerprint(p, p->taut_row_list + pos, cnt, &fp1, &fp2);
+  e = bcp_find_taut_cache(p, fp1, fp2, cnt);
+  if ( e != NULL )
+  {
+    if ( e->is_tautology != 0 || p->taut_minterm == NULL )
+      return e->is_tautology;
+    if ( e->is_minterm != 0 )
+    {
+      bcp_copy_rows_minterm(p, p->taut_row_list + pos, cnt, p->taut_cache_minterm_list + (size_t)(e-p->taut_cache)*p->blk_cnt);
+      return 0;
+    }
+    // the result was calculated without minterm, calculate again and store the minterm
+  }
+  result = bcp_is_taut_rows_calc(p, pos, cnt, depth, slot);
+  if ( result >= 0 && bcp_IsGovernorExceeded(p) == 0 )      // don't store the conservative result
+    bcp_add_taut_cache(p, fp1, fp2, cnt, result);
+  return result;
+}
+
+/*
+  check whether "l" is a tautology.
+  The cubes of "l" are modified during the test, but all modifications are reverted.
+*/
 int bcp_IsBCLTautology(bcp p, bcl l)
 {
-  return bcp_IsBCLTautologySub(p, l, 0, 0);
+  int i;
+  int pos = p->taut_row_cnt;
+  int cnt = 0;
+  int result;
+  
+  bcp_prepare_taut_cache(p);
+  if ( bcp_reserve_taut_rows(p, l->cnt) == 0 )
+    return bcp_IsBCLTautologyWithCopy(p, l);
+  for( i = 0; i < l->cnt; i++ )
+    if ( l->flags[i] == 0 )
+      p->taut_row_list[pos+cnt++] = bcp_GetBCLCube(p, l, i);
+  p->taut_row_cnt = pos + cnt;
+  result = bcp_is_taut_rows(p, pos, cnt, 0, -1);
+  p->taut_row_cnt = pos;
+  if ( result < 0 )
+    return bcp_IsBCLTautologyWithCopy(p, l);      // memory error
+  return result;
+}
+
+/*
+  check whether "l" is a tautology. If "l" is not a tautology, then a minterm which is not 
+  covered by "l" is stored in "minterm": All variables are either zero or one.
+  returns:
+    1: "l" is a tautology, "minterm" is not modified
+    0: "l" is not a tautology, "minterm" contains the counterexample
+    -1: memory error or budget exceeded (see bcgovernor.c), "minterm" is not valid
+*/
+int bcp_IsBCLTautologyWithMinterm(bcp p, bcl l, bc minterm)
+{
+  int i;
+  int pos = p->taut_row_cnt;
+  int cnt = 0;
+  int result;
+  bc prev_minterm = p->taut_minterm;
+  
+  bcp_prepare_taut_cache(p);
+  if ( bcp_reserve_taut_rows(p, l->cnt) == 0 )
+    return -1;
+  for( i = 0; i < l->cnt; i++ )
+    if ( l->flags[i] == 0 )
+      p->taut_row_list[pos+cnt++] = bcp_GetBCLCube(p, l, i);
+  p->taut_row_cnt = pos + cnt;
+  
+  /* variables, which are not assigned by the recursion, can have any value, use zero */
+  bcp_CopyCube(p, minterm, bcp_GetGlobalCube(p, 1));
+  p->taut_minterm = minterm;
+  result = bcp_is_taut_rows(p, pos, cnt, 0, -1);
+  p->taut_minterm = prev_minterm;
+  p->taut_row_cnt = pos;
+  if ( result == 0 && bcp_IsGovernorExceeded(p) )
+    return -1;          // budget exceeded, the minterm is not valid
+  return result;
 }
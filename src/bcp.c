@@ -46,6 +46,34 @@ static void bcp_var_cnt_clear(bcp p)
   p->exclude_group_list = NULL;
   free(p->cube_to_str);
   p->cube_to_str = NULL;
+  free(p->taut_cache);          // cached results depend on the number of variables
+  free(p->taut_cache_minterm_list);
+  p->taut_cache = NULL;
+  p->taut_cache_minterm_list = NULL;
+  p->taut_cache_alloc_size = 0;
+  free(p->taut_row_list);
+  p->taut_row_list = NULL;
+  p->taut_row_max = 0;
+  free(p->taut_part_list);
+  p->taut_part_list = NULL;
+  p->taut_part_max = 0;
+  free(p->taut_var_cnt_list);
+  p->taut_var_cnt_list = NULL;
+  p->taut_var_cnt_cnt = 0;
+  p->taut_var_cnt_max = 0;
+  bcp_DeleteBCL(p, p->cover_cex_list);
+  p->cover_cex_list = NULL;
+  bcp_ClearResultCache(p);      // cached results depend on the number of variables
+  free(p->subtract_stat.size_list);
+  free(p->subtract_stat.clock_list);
+  p->subtract_stat.size_list = NULL;
+  p->subtract_stat.clock_list = NULL;
+  p->subtract_stat.list_max = 0;
+  free(p->espresso_stat.cube_cnt_list);
+  free(p->espresso_stat.literal_cnt_list);
+  p->espresso_stat.cube_cnt_list = NULL;
+  p->espresso_stat.literal_cnt_list = NULL;
+  p->espresso_stat.list_max = 0;
 }
 
 static void _bcp_SetCubeVar(bcp p, bc c, unsigned var_pos, unsigned value)
@@ -66,6 +94,23 @@ static int bcp_var_cnt_init(bcp p, size_t var_cnt)
   p->bytes_per_cube_cnt = p->blk_cnt*sizeof(__m128i);
   //printf("p->bytes_per_cube_cnt=%d\n", p->bytes_per_cube_cnt);
   p->stack_depth = 0;
+  p->taut_cache = NULL;
+  p->taut_cache_minterm_list = NULL;
+  p->taut_cache_alloc_size = 0;
+  p->taut_row_list = NULL;
+  p->taut_row_cnt = 0;
+  p->taut_row_max = 0;
+  p->taut_part_list = NULL;
+  p->taut_part_max = 0;
+  p->taut_var_cnt_list = NULL;
+  p->taut_var_cnt_cnt = 0;
+  p->taut_var_cnt_max = 0;
+  p->taut_minterm = NULL;
+  p->cover_cex_list = NULL;
+  p->cover_cex_pos = 0;
+  p->result_cache = NULL;
+  p->result_cache_alloc_size = 0;
+  p->result_cache_pos = 0;
   p->cube_to_str = (char *)malloc(p->var_cnt+1); 
   if ( p->cube_to_str != NULL )
   {
@@ -81,12 +126,8 @@ static int bcp_var_cnt_init(bcp p, size_t var_cnt)
           int i;
                       /*
                               0..3:	constant cubes for all illegal, all zero, all one and all don't care
-                              4..7:	uint8_t counters for zeros in a list
-                              8..11:	uint8_t counters for ones in a list
-                              4..11: uint16_t counters
-                              12..19: uint16_t counters
                       */
-          for( i = 0; i < 4+8+8; i++ )
+          for( i = 0; i < 4; i++ )
             bcp_AddBCLCube(p, p->global_cube_list);
           if ( p->global_cube_list->cnt >= 4 )
           {
@@ -137,6 +178,28 @@ bcp bcp_New(size_t var_cnt)
       p->x_var_cnt = 0;
 	  
       p->clock_do_bcl_multi_cube_containment = 1*CLOCKS_PER_SEC;
+      bcp_SetGovernor(p, 0.0, 0, 0);    // no limits
+      
+      p->taut_cache_size = 4096;
+      p->taut_cache_min_cnt = 8;
+      p->taut_cache_hand = 0;
+      p->taut_tt_max_var_cnt = BCP_TAUT_TT_MAX_VAR_CNT;
+      p->taut_cache_hit_cnt = 0;
+      p->taut_cache_miss_cnt = 0;
+      p->cover_cex_size = 32;
+      p->cover_cex_hit_cnt = 0;
+      p->subtract_order = BCP_SUBTRACT_ORDER_LIST;
+      memset(&(p->subtract_stat), 0, sizeof(struct bcp_subtract_stat_struct));
+      p->minimize_mode = BCP_MINIMIZE_MODE_DEFAULT;
+      memset(&(p->espresso_stat), 0, sizeof(struct bcp_espresso_stat_struct));
+      p->is_minimize_exact = 0;
+      p->result_cache_size = 16;
+      p->result_cache_min_cnt = 8;
+      p->result_cache_hit_cnt = 0;
+      p->result_cache_miss_cnt = 0;
+      p->spill_cnt = 0;
+      p->spill_dir = NULL;
+      p->spill_list_cnt = 0;
     
       if ( bcp_var_cnt_init(p, var_cnt) != 0 )
       {
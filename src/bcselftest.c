@@ -462,6 +462,59 @@ static void expression_test_sub(const char *cubes, const char *expression, int i
   bcp_Delete(p);
 }
 
+/*
+  compare the cube list of "expression" with "fn" for all minterms,
+  bit i of the minterm is the value of the i-th variable of the expression
+*/
+static void expression_minterm_test_sub(const char *expression, int is_not_propagation, int var_cnt, int (*fn)(unsigned m))
+{
+  bcp p;
+  bcx x;
+  bcl l;
+  bc c;
+  unsigned m;
+  int v;
+
+  printf("Minterm test '%s'\n", expression);
+  p = bcp_New(0);
+  x = bcp_Parse(p, expression, is_not_propagation, 1);
+  assert(x != NULL);
+  bcp_UpdateFromBCX(p);
+  assert( p->var_cnt == var_cnt );
+  l = bcp_NewBCLByBCX(p, x);
+  bcp_DeleteBCX(p, x);
+  assert( l != NULL );
+
+  bcp_StartCubeStackFrame(p);
+  c = bcp_GetTempCube(p);
+  for( m = 0; m < (1u<<var_cnt); m++ )
+  {
+    for( v = 0; v < var_cnt; v++ )
+      bcp_SetCubeVar(p, c, v, ((m>>v)&1) ? 2 : 1);
+    assert( bcp_IsBCLCubeCovered(p, l, c) == (fn(m) != 0) );
+  }
+  bcp_EndCubeStackFrame(p);
+
+  bcp_DeleteBCL(p, l);
+  bcp_Delete(p);
+}
+
+#define M(i) ((m>>(i))&1)
+static int expression_and_chain_fn(unsigned m)      // (a|b|c)&(b|-d)&(a|c|d|e)&-e
+{
+  return (M(0) || M(1) || M(2)) && (M(1) || !M(3)) && (M(0) || M(2) || M(3) || M(4)) && !M(4);
+}
+static int expression_and_chain2_fn(unsigned m)      // (a|b)&(-a|c)&(b|-c|d)&(-b|-d)
+{
+  return (M(0) || M(1)) && (!M(0) || M(2)) && (M(1) || !M(2) || M(3)) && (!M(1) || !M(3));
+}
+static int expression_and_empty_fn(unsigned m)
+{
+  (void)m;
+  return 0;
+}
+#undef M
+
 void expressionTest(void)   // called from main.c if command line option -test is provided
 {
   expression_test_sub("1", "a", 1);
@@ -473,6 +526,11 @@ void expressionTest(void)   // called from main.c if command line option -test i
   expression_test_sub("--11\n1--1\n-1-1\n", "(a|b|c)&d", 1);
   expression_test_sub("--11\n1--1\n-1-1\n", "-(-a&-b&-c)&d", 1);
   expression_test_sub("--11\n1--1\n-1-1\n", "-(-a&-b&-c)&d", 0);
+  expression_test_sub("1-1-\n1--1\n", "(a|b)&(c|d)&a", 1);          // AND children are intersected in the order of their size
+  expression_test_sub("1100\n", "(a|b|c|d)&(a|-b)&a&b&-c&-d", 1);
+  expression_minterm_test_sub("(a|b|c)&(b|-d)&(a|c|d|e)&-e", 1, 5, expression_and_chain_fn);
+  expression_minterm_test_sub("(a|b)&(-a|c)&(b|-c|d)&(-b|-d)", 1, 4, expression_and_chain2_fn);
+  expression_minterm_test_sub("(a|b)&-(c|-c)&d", 0, 4, expression_and_empty_fn);       // empty AND child, the remaining children are not calculated
 }
 
 
@@ -609,7 +667,9 @@ void generated_test_cases(void)
   bc cube;
   int *vcl;
   int pos;
+  int i, j;
   int tautology;
+  long hit_cnt;
 
   printf("Generated test cases\n");
 
@@ -766,6 +826,22 @@ void generated_test_cases(void)
   assert(off != NULL);
   generated_expect_equal_cubes(p, "bcp_NewBCLCofactorByCube", off, "-1-\n011\n");
   bcp_DeleteBCL(p, off);
+  off = bcp_NewBCLIntersectingCofactorByCube(p, d, cube, -1);
+  assert(off != NULL);
+  assert(off->cnt == 2);                                // "011" does not intersect with "1--"
+  assert(bcp_IsBCLTautology(p, off) == 0);
+  bcp_DeleteBCL(p, off);
+  bcp_SetCubeByString(p, cube, "111");
+  off = bcp_NewBCLIntersectingCofactorByCube(p, d, cube, -1);
+  assert(off != NULL);
+  assert(off->cnt == 1);                                // "111" is part of the list
+  generated_expect_equal_cubes(p, "bcp_NewBCLIntersectingCofactorByCube covered", off, "---\n");
+  bcp_DeleteBCL(p, off);
+  bcp_SetCubeByString(p, cube, "00-");
+  off = bcp_NewBCLIntersectingCofactorByCube(p, d, cube, -1);
+  assert(off != NULL);
+  assert(off->cnt == 0);                                // no intersection
+  bcp_DeleteBCL(p, off);
   bcp_EndCubeStackFrame(p);
 
   bcp_DeleteBCL(p, d);
@@ -882,4 +958,752 @@ void generated_test_cases(void)
   bcp_DeleteBCL(p, grp_list);
   bcp_DeleteBCL(p, a);
   bcp_Delete(p);
-}
\ No newline at end of file
+  p = bcp_New(12);
+  assert(p != NULL);
+  printf("Generated tautology cache tests\n");
+  p->taut_cache_min_cnt = 2;
+  p->taut_tt_max_var_cnt = 0;                           // the truth table would answer before the cache
+  a = bcp_NewBCLWithRandomTautology(p, 12, 0);
+  b = bcp_NewBCLWithRandomTautology(p, 12, 12);
+  assert(bcp_IsBCLTautology(p, a) == 1);
+  assert(bcp_IsBCLTautology(p, b) == 0);
+  pos = p->taut_cache_hit_cnt;
+  assert(bcp_IsBCLTautology(p, a) == 1);                // second test must be answered from the cache
+  assert(bcp_IsBCLTautology(p, b) == 0);
+  assert(p->taut_cache_hit_cnt >= pos + 2);
+  p->taut_cache_size = 4;                               // very small cache: force replacement of entries
+  assert(bcp_IsBCLTautology(p, a) == 1);
+  assert(bcp_IsBCLTautology(p, b) == 0);
+  assert(p->taut_cache_alloc_size == 4);
+  
+  printf("Generated in-place tautology tests\n");
+  p->taut_cache_size = 0;                               // compare both implementations without cache
+  pos = p->taut_cache_hit_cnt;
+  assert(bcp_IsBCLTautologyWithCopy(p, a) == 1);
+  assert(bcp_IsBCLTautologyWithCopy(p, b) == 0);
+  assert(p->taut_cache == NULL);
+  c = bcp_NewBCLByBCL(p, b);
+  assert(bcp_IsBCLTautology(p, a) == 1);
+  assert(bcp_IsBCLTautology(p, b) == 0);
+  assert(p->taut_cache_hit_cnt == pos);                 // both results are calculated
+  assert(memcmp(b->list, c->list, b->cnt*p->bytes_per_cube_cnt) == 0);   // all modifications must be reverted
+  bcp_DeleteBCL(p, c);
+  bcp_DeleteBCL(p, b);
+  bcp_DeleteBCL(p, a);
+  bcp_Delete(p);
+  
+  printf("Generated column statistics tests\n");
+  p = bcp_New(150);                                     // three blocks, the last one is only partly used
+  assert(p != NULL);
+  for( pos = 0; pos < 20; pos++ )
+  {
+    int var_pos;
+    a = bcp_NewBCLWithRandomTautology(p, 40, pos);
+    assert(bcp_CalcBCLBinateSplitVariableTable(p, a) != 0);
+    assert(bcp_GetBCLMaxBinateSplitVariable(p, a) == bcp_GetBCLMaxBinateSplitVariableSimple(p, a));
+    var_pos = bcp_GetBCLMaxBinateSplitVariable(p, a);
+    assert(var_pos >= 0);
+    assert(bcp_IsBCLUnate(p, a) == 0);
+    b = bcp_NewBCLCofacterByVariable(p, a, var_pos, 1+(pos&1));   // the table of "b" is derived from the table of "a"
+    assert(b->is_var_cnt_valid != 0);
+    c = bcp_NewBCLByBCL(p, b);
+    bcp_InvalidateBCLVarCnt(p, c);
+    assert(bcp_CalcBCLBinateSplitVariableTable(p, c) != 0);
+    assert(memcmp(b->var_cnt_list, c->var_cnt_list, bcp_GetVarCntListSize(p)*sizeof(uint32_t)) == 0);
+    assert(bcp_GetBCLMaxBinateSplitVariable(p, b) == bcp_GetBCLMaxBinateSplitVariableSimple(p, b));
+    bcp_DeleteBCL(p, c);
+    bcp_DeleteBCL(p, b);
+    bcp_DeleteBCL(p, a);
+  }
+  a = bcp_NewBCL(p);
+  for( pos = 0; pos < 70000; pos++ )                   // more cubes than a 16 bit counter can count
+  {
+    bcp_AddBCLCubeByCube(p, a, bcp_GetGlobalCube(p, 3));
+    bcp_SetCubeVar(p, bcp_GetBCLCube(p, a, pos), 140, pos < 69000 ? 1 : 2);
+    bcp_SetCubeVar(p, bcp_GetBCLCube(p, a, pos), 7, pos < 35000 ? 1 : 2);
+  }
+  assert(bcp_IsBCLUnate(p, a) == 0);
+  assert(bcp_CalcBCLBinateSplitVariableTable(p, a) != 0);
+  assert(a->var_cnt_list[bcp_GetVarCntZeroPos(p, 140)] == 69000);
+  assert(a->var_cnt_list[bcp_GetVarCntOnePos(p, 7)] == 35000);
+  assert(bcp_GetBCLMaxBinateSplitVariable(p, a) == 7);  // both variables have 70000 literals, take the lower one
+  bcp_DeleteBCL(p, a);
+  bcp_Delete(p);
+  
+  printf("Generated partition tautology tests\n");
+  p = bcp_New(6);
+  assert(p != NULL);
+  p->taut_cache_size = 0;
+  p->taut_tt_max_var_cnt = 0;
+  a = bcp_NewBCLByString(p, "00----\n----1-\n01----\n--0---\n10----\n--1---\n");
+  b = bcp_NewBCLByString(p, "00----\n----1-\n01----\n--00--\n10----\n--1---\n-----0\n");
+  assert(bcp_is_bcl_partition(p, a) != 0);
+  assert(a->flags[0] == 0 && a->flags[2] == 0 && a->flags[4] == 0);      // same component as the first cube
+  assert(a->flags[1] == 1 && a->flags[3] == 1 && a->flags[5] == 1);
+  memset(a->flags, 0, a->cnt);
+  assert(bcp_IsBCLTautology(p, a) == 1);                // only the second component is a tautology
+  assert(bcp_IsBCLTautology(p, b) == 0);
+  assert(bcp_IsBCLTautologyWithCopy(p, a) == 1);
+  assert(bcp_IsBCLTautologyWithCopy(p, b) == 0);
+  bcp_DeleteBCL(p, b);
+  bcp_DeleteBCL(p, a);
+  bcp_Delete(p);
+  
+  printf("Generated truth table tautology tests\n");
+  for( pos = 3; pos <= 16; pos++ )
+  {
+    p = bcp_New(pos+70);                                // support variables are spread over two blocks
+    assert(p != NULL);
+    p->taut_cache_size = 0;
+    a = bcp_NewBCLWithRandomTautology(p, pos+1, 0);      // at most pos variables are used
+    b = bcp_NewBCLWithRandomTautology(p, pos+1, 2);
+    p->taut_tt_max_var_cnt = 0;
+    assert(bcp_IsBCLTautology(p, a) == 1);
+    assert(bcp_IsBCLTautology(p, b) == 0);
+    p->taut_tt_max_var_cnt = BCP_TAUT_TT_MAX_VAR_CNT;
+    assert(bcp_IsBCLTautology(p, a) == 1);
+    assert(bcp_IsBCLTautology(p, b) == 0);
+    bcp_DeleteBCL(p, b);
+    bcp_DeleteBCL(p, a);
+    bcp_Delete(p);
+  }
+  
+  printf("Generated counterexample cache tests\n");
+  for( pos = 0; pos < 40; pos++ )
+  {
+    int i, covered;
+    long hit_cnt;
+    p = bcp_New(pos < 20 ? 12 : 150);
+    assert(p != NULL);
+    p->taut_tt_max_var_cnt = (pos & 1) ? BCP_TAUT_TT_MAX_VAR_CNT : 0;
+    a = bcp_NewBCLWithRandomTautology(p, pos < 20 ? 10 : 30, 2);
+    b = bcp_NewBCLWithRandomTautology(p, pos < 20 ? 10 : 30, 0);
+    c = bcp_NewBCL(p);
+    bcp_AddBCLCube(p, c);
+    assert(bcp_IsBCLTautologyWithMinterm(p, a, bcp_GetBCLCube(p, c, 0)) == 0);
+    for( i = 0; i < (int)p->var_cnt; i++ )
+      assert(bcp_GetCubeVar(p, bcp_GetBCLCube(p, c, 0), i) == 1 || bcp_GetCubeVar(p, bcp_GetBCLCube(p, c, 0), i) == 2);
+    assert(bcp_IsBCLCubeSingleCovered(p, a, bcp_GetBCLCube(p, c, 0)) == 0);       // the minterm is outside of "a"
+    assert(bcp_IsBCLTautologyWithMinterm(p, b, bcp_GetBCLCube(p, c, 0)) == 1);
+    for( i = 0; i < b->cnt; i++ )
+    {
+      p->cover_cex_size = 0;
+      covered = bcp_IsBCLCubeCovered(p, a, bcp_GetBCLCube(p, b, i));
+      p->cover_cex_size = 4;
+      assert(bcp_IsBCLCubeCovered(p, a, bcp_GetBCLCube(p, b, i)) == covered);
+      if ( covered == 0 )
+      {
+        hit_cnt = p->cover_cex_hit_cnt;
+        assert(bcp_IsBCLCubeRefutedByCache(p, a, bcp_GetBCLCube(p, b, i)) == 1);
+        assert(bcp_IsBCLCubeCovered(p, a, bcp_GetBCLCube(p, b, i)) == 0);
+        assert(p->cover_cex_hit_cnt == hit_cnt + 2);
+      }
+    }
+    assert(bcp_IsBCLSubset(p, b, a) == 1);
+    assert(bcp_IsBCLSubset(p, a, b) == 0);
+    bcp_DeleteBCL(p, c);
+    bcp_DeleteBCL(p, b);
+    bcp_DeleteBCL(p, a);
+    bcp_Delete(p);
+  }
+  
+  printf("Generated single cube containment tests\n");
+  for( pos = 0; pos < 20; pos++ )
+  {
+    int i, j;
+    p = bcp_New(pos < 10 ? 20 : 150);
+    assert(p != NULL);
+    a = bcp_NewBCLWithRandomTautology(p, 30, pos & 3);
+    for( i = 0; i < 30; i++ )                             // add duplicates and subsets of the existing cubes
+    {
+      j = bcp_AddBCLCubeByCube(p, a, bcp_GetBCLCube(p, a, i));
+      assert(j >= 0);
+      if ( i & 1 )
+        bcp_SetCubeVar(p, bcp_GetBCLCube(p, a, j), (i*7) % p->var_cnt, 1 + (i & 2)/2);
+    }
+    b = bcp_NewBCLByBCL(p, a);
+    bcp_DoBCLSingleCubeContainment(p, a);
+    assert(a->cnt < b->cnt);
+    for( i = 0; i < b->cnt; i++ )
+      assert(bcp_IsBCLCubeSingleCovered(p, a, bcp_GetBCLCube(p, b, i)) != 0);
+    for( i = 0; i < a->cnt; i++ )
+      for( j = 0; j < a->cnt; j++ )
+        if ( i != j )
+          assert(bcp_IsSubsetCube(p, bcp_GetBCLCube(p, a, i), bcp_GetBCLCube(p, a, j)) == 0);
+    for( i = 0; i < b->cnt; i++ )
+      for( j = 0; j < b->cnt; j++ )
+        if ( bcp_IsSubsetCube(p, bcp_GetBCLCube(p, b, i), bcp_GetBCLCube(p, b, j)) )
+          assert((bcp_GetCubeLiteralSignature(p, bcp_GetBCLCube(p, b, i)) & ~bcp_GetCubeLiteralSignature(p, bcp_GetBCLCube(p, b, j))) == 0);
+    bcp_DeleteBCL(p, b);
+    bcp_DeleteBCL(p, a);
+    bcp_Delete(p);
+  }
+  
+  printf("Generated resource governor tests\n");
+  p = bcp_New(150);
+  assert(p != NULL);
+  p->taut_tt_max_var_cnt = 0;                           // more than one node
+  a = bcp_NewBCLWithRandomTautology(p, 40, 0);
+  b = bcp_NewBCLWithRandomTautology(p, 40, 2);
+  bcp_SetGovernor(p, 0.0, 3, 0);                        // node limit
+  assert(bcp_IsBCLTautology(p, a) == 0);                // conservative result
+  assert(bcp_IsGovernorExceeded(p) != 0);
+  assert(bcp_NewBCLComplementWithCofactor(p, b) == NULL);
+  c = bcp_NewBCLByBCL(p, a);
+  assert(bcp_IntersectionBCL(p, c, b) == 0);
+  assert(c->cnt == a->cnt);                             // not modified
+  bcp_DeleteBCL(p, c);
+  bcp_StartGovernor(p);
+  assert(bcp_IsGovernorExceeded(p) == 0);
+  bcp_SetGovernor(p, 0.0, 0, 0);                        // no limits
+  assert(bcp_IsBCLTautology(p, a) == 1);                // the conservative result is not cached
+  assert(bcp_IsGovernorExceeded(p) == 0);
+  bcp_SetGovernor(p, 0.0, 0, 64);                       // cube limit
+  c = bcp_NewBCL(p);
+  for( pos = 0; pos < 100; pos++ )
+    if ( bcp_AddBCLCube(p, c) < 0 )
+      break;
+  assert(pos < 100);
+  assert(c->cnt >= 64);
+  assert(bcp_IsGovernorExceeded(p) != 0);
+  bcp_DeleteBCL(p, c);
+  bcp_SetGovernor(p, 0.000001, 0, 0);                   // time limit: one clock tick
+  {
+    clock_t t = bcp_GetMonotonicClock();
+    while( bcp_GetMonotonicClock() - t < 3 )
+      ;
+  }
+  assert(bcp_CheckGovernor(p) == 0);
+  bcp_SetGovernor(p, 0.0, 0, 0);
+  assert(bcp_CheckGovernor(p) != 0);
+  bcp_DeleteBCL(p, b);
+  bcp_DeleteBCL(p, a);
+  bcp_Delete(p);
+
+  printf("Generated literal index tests\n");
+  for( pos = 0; pos < 4; pos++ )
+  {
+    int i, j, k, n;
+    bci x;
+    bc cube;
+    p = bcp_New(pos < 2 ? 12 : 100);
+    assert(p != NULL);
+    a = bcp_NewBCL(p);
+    srand(pos);
+    for( i = 0; i < BCP_SCC_INDEX_MIN_CNT+200; i++ )      // random cubes, large enough for the index in the SCC
+    {
+      k = bcp_AddBCLCubeByCube(p, a, bcp_GetGlobalCube(p, 3));
+      assert(k >= 0);
+      for( j = 0; j < p->var_cnt; j++ )
+        if ( rand() % (pos < 2 ? 3 : 12) == 0 )
+          bcp_SetCubeVar(p, bcp_GetBCLCube(p, a, k), j, 1 + rand()%2);
+    }
+    bcp_SetCubeVar(p, bcp_GetBCLCube(p, a, 5), 3, 0);     // illegal cube
+    bcp_CopyCube(p, bcp_GetBCLCube(p, a, 9), bcp_GetBCLCube(p, a, 7));
+    bcp_SetCubeVar(p, bcp_GetBCLCube(p, a, 9), 3, 0);     // illegal cube, subset of cube 7
+    x = bcp_NewBCI(p, a);
+    assert(x != NULL);
+    for( i = 0; i < 200; i++ )
+    {
+      cube = bcp_GetBCLCube(p, a, i);
+      k = bcp_FindBCISupersetCube(p, x, a, cube, i);
+      for( j = 0; j < a->cnt; j++ )
+        if ( j != i && bcp_IsSubsetCube(p, bcp_GetBCLCube(p, a, j), cube) )
+          break;
+      assert((k >= 0) == (j < a->cnt));
+      assert(k < 0 || bcp_IsSubsetCube(p, bcp_GetBCLCube(p, a, k), cube));
+    }
+    assert(bcp_FindBCISupersetCube(p, x, a, bcp_GetBCLCube(p, a, 9), 9) >= 0);
+    b = bcp_NewBCLByBCL(p, a);
+    for( i = 0; i < 200; i++ )
+    {
+      cube = bcp_GetBCLCube(p, a, i);
+      for( j = 0, n = 0; j < b->cnt; j++ )
+        if ( j != i && b->flags[j] == 0 && bcp_IsSubsetCube(p, cube, bcp_GetBCLCube(p, b, j)) )
+          n++;
+      assert(bcp_DoBCISubsetCubeMark(p, x, b, cube, i) == n);       // b has the same cube positions as a
+    }
+    assert(b->flags[9] != 0);
+    bcp_DeleteBCL(p, b);
+    bcp_DeleteBCI(p, x);
+    
+    bcp_SetCubeVar(p, bcp_GetBCLCube(p, a, 5), 3, 3);     // make the cubes legal again
+    bcp_SetCubeVar(p, bcp_GetBCLCube(p, a, 9), 3, 3);
+    b = bcp_NewBCLByBCL(p, a);
+    bcp_DoBCLSingleCubeContainment(p, a);                 // index based SCC
+    for( i = 0; i < b->cnt; i++ )
+      assert(bcp_IsBCLCubeSingleCovered(p, a, bcp_GetBCLCube(p, b, i)) != 0);
+    for( i = 0; i < a->cnt; i++ )
+      for( j = 0; j < a->cnt; j++ )
+        if ( i != j )
+          assert(bcp_IsSubsetCube(p, bcp_GetBCLCube(p, a, i), bcp_GetBCLCube(p, a, j)) == 0);
+    bcp_DeleteBCL(p, b);
+    bcp_DeleteBCL(p, a);
+    bcp_Delete(p);
+  }
+  printf("Generated irredundant tests\n");
+  for( pos = 0; pos < 6; pos++ )
+  {
+    int i;
+    p = bcp_New(pos < 3 ? 8 : 12);
+    assert(p != NULL);
+    a = bcp_NewBCLWithRandomTautology(p, pos < 3 ? 12 : 30, pos % 3 + 1);
+    b = bcp_NewBCLComplement(p, a);                       // off-set
+    assert(b != NULL);
+    c = bcp_NewBCL(p);
+    assert(bcp_AddBCLCubeByCube(p, c, bcp_GetGlobalCube(p, 3)) >= 0);
+    assert(bcp_SubtractBCL(p, c, b, 0) != 0);             // all primes, many of them are redundant
+    bcp_DeleteBCL(p, b);
+    b = bcp_NewBCLByBCL(p, c);
+    bcp_DoBCLIrredundant(p, c);
+    assert(c->cnt <= b->cnt);
+    assert(bcp_IsBCLEqual(p, b, c) != 0);
+    for( i = 0; i < c->cnt; i++ )
+      assert(bcp_IsBCLCubeRedundant(p, c, i) == 0);
+    bcp_DeleteBCL(p, c);
+    bcp_DeleteBCL(p, b);
+    bcp_DeleteBCL(p, a);
+    bcp_Delete(p);
+  }
+
+  printf("Generated disjoint sharp tests\n");
+  for( pos = 0; pos < 6; pos++ )
+  {
+    int i, j;
+    double total;
+    p = bcp_New(pos < 3 ? 8 : 14);
+    assert(p != NULL);
+    a = bcp_NewBCLWithRandomTautology(p, pos < 3 ? 12 : 30, pos % 3 + 1);
+    b = bcp_NewBCLDisjointComplement(p, a);
+    assert(b != NULL);
+    for( i = 0; i < b->cnt; i++ )
+      for( j = i+1; j < b->cnt; j++ )
+        assert(bcp_IsIntersectionCube(p, bcp_GetBCLCube(p, b, i), bcp_GetBCLCube(p, b, j)) == 0);
+    c = bcp_NewBCLComplement(p, a);
+    assert(c != NULL);
+    assert(bcp_IsBCLEqual(p, b, c) != 0);
+    bcp_DeleteBCL(p, c);
+    c = bcp_NewBCLDisjointComplement(p, b);               // disjoint version of "a"
+    assert(c != NULL);
+    assert(bcp_IsBCLEqual(p, a, c) != 0);
+    total = 1.0;
+    for( i = 0; i < p->var_cnt; i++ )
+      total *= 2.0;
+    assert(bcp_GetBCLMintermCount(p, b) + bcp_GetBCLMintermCount(p, c) == total);
+    bcp_DeleteBCL(p, c);
+    bcp_DeleteBCL(p, b);
+    bcp_DeleteBCL(p, a);
+    bcp_Delete(p);
+  }
+  printf("Generated recursive complement tests\n");
+  p = bcp_New(8);
+  assert(p != NULL);
+  a = bcp_NewBCLByString(p, "11------\n--0-----\n----1-0-\n-----0-1\n");     // unate, partitioned
+  b = bcp_NewBCLComplementWithCofactor(p, a);
+  assert(b != NULL);
+  assert(b->cnt == 8);                                  // (!x0 + !x1) x2 (!x4 + x6) (x5 + !x7)
+  c = bcp_NewBCLComplementWithSubtract(p, a);
+  assert(bcp_IsBCLEqual(p, b, c) != 0);
+  bcp_DeleteBCL(p, c);
+  bcp_DeleteBCL(p, b);
+  bcp_DeleteBCL(p, a);
+  a = bcp_NewBCLByString(p, "1--1----\n1--0----\n1-x-----\n");           // common cube and illegal cube
+  b = bcp_NewBCLComplementWithCofactor(p, a);
+  assert(b != NULL);
+  assert(b->cnt == 1);
+  assert(bcp_IsBCLEqual(p, b, c = bcp_NewBCLByString(p, "0-------\n")) != 0);
+  bcp_DeleteBCL(p, c);
+  bcp_DeleteBCL(p, b);
+  bcp_DeleteBCL(p, a);
+  bcp_Delete(p);
+  for( pos = 0; pos < 12; pos++ )
+  {
+    int i, j;
+    p = bcp_New(12);
+    assert(p != NULL);
+    if ( pos < 4 )
+      a = bcp_NewBCLWithRandomTautology(p, 14, pos);
+    else
+    {
+      a = bcp_NewBCL(p);
+      for( i = 0; i < pos*3; i++ )
+      {
+        bcp_AddBCLCubeByCube(p, a, bcp_GetGlobalCube(p, 3));
+        for( j = 0; j < 4; j++ )        // random binate cubes, odd lists use only the first half of the variables
+          bcp_SetCubeVar(p, bcp_GetBCLCube(p, a, i), rand() % (pos & 1 ? 6 : 12), rand() % 2 + 1);
+      }
+    }
+    b = bcp_NewBCLComplementWithCofactor(p, a);
+    c = bcp_NewBCLComplementWithSubtract(p, a);
+    assert(b != NULL && c != NULL);
+    assert(bcp_IsBCLEqual(p, b, c) != 0);
+    bcp_DeleteBCL(p, c);
+    bcp_DeleteBCL(p, b);
+    bcp_DeleteBCL(p, a);
+    bcp_Delete(p);
+  }
+  printf("Generated result cache tests\n");
+  p = bcp_New(10);
+  assert(p != NULL);
+  p->result_cache_min_cnt = 1;
+  a = bcp_NewBCLWithRandomTautology(p, 16, 2);
+  b = bcp_NewBCLComplement(p, a);
+  assert(b != NULL && p->result_cache_hit_cnt == 0);
+  bcp_ClearBCL(p, b);                                   // modify the result of the caller
+  c = bcp_NewBCLComplement(p, a);
+  assert(c != NULL && p->result_cache_hit_cnt == 1);
+  bcp_DeleteBCL(p, b);
+  b = bcp_NewBCLComplementWithCofactor(p, a);
+  assert(bcp_IsBCLEqual(p, b, c) != 0);
+  bcp_DeleteBCL(p, b);
+  assert(bcp_IsBCLSubset(p, a, c) == 0);
+  hit_cnt = p->result_cache_hit_cnt;
+  assert(bcp_IsBCLSubset(p, a, c) == 0 && p->result_cache_hit_cnt == hit_cnt+1);
+  b = bcp_NewBCLByBCL(p, c);
+  d = bcp_NewBCLByBCL(p, c);
+  bcp_MinimizeBCL(p, b);
+  bcp_MinimizeBCL(p, d);
+  assert(p->result_cache_hit_cnt == hit_cnt+2);
+  assert(b->cnt == d->cnt && bcp_IsBCLEqual(p, b, c) != 0);
+  bcp_DeleteBCL(p, d);
+  hit_cnt = p->result_cache_hit_cnt;
+  p->result_cache_size = 0;                             // the cache is disabled, but still allocated
+  bcp_MinimizeBCL(p, b);
+  assert(p->result_cache_hit_cnt == hit_cnt);
+  bcp_ClearResultCache(p);
+  bcp_DeleteBCL(p, c);
+  bcp_DeleteBCL(p, b);
+  bcp_DeleteBCL(p, a);
+  bcp_Delete(p);
+  printf("Generated incremental subtract tests\n");
+  for( pos = 0; pos < 8; pos++ )
+  {
+    int i, j;
+    p = bcp_New(16);
+    assert(p != NULL);
+    a = bcp_NewBCLWithRandomTautology(p, 40, pos);
+    b = bcp_NewBCLWithRandomTautology(p, 20, 2);
+    while( b->cnt > pos+2 )
+      b->flags[--b->cnt] = 0;                           // keep the first cubes only
+    c = bcp_NewBCLByBCL(p, a);
+    assert(bcp_SubtractBCL(p, c, b, pos & 1) != 0);
+    for( i = 0; i < c->cnt; i++ )                       // no cube is inside another cube
+      for( j = 0; j < c->cnt; j++ )
+        assert(i == j || bcp_IsSubsetCube(p, bcp_GetBCLCube(p, c, i), bcp_GetBCLCube(p, c, j)) == 0);
+    d = bcp_NewBCLComplement(p, b);
+    assert(bcp_IntersectionBCL(p, d, a) != 0);        // a - b = a & !b
+    assert(bcp_IsBCLEqual(p, c, d) != 0);
+    bcp_DeleteBCL(p, d);
+    bcp_DeleteBCL(p, c);
+    bcp_DeleteBCL(p, b);
+    bcp_DeleteBCL(p, a);
+    bcp_Delete(p);
+  }
+  printf("Generated subtract order tests\n");
+  p = bcp_New(12);
+  assert(p != NULL);
+  a = bcp_NewBCLWithRandomTautology(p, 30, 3);
+  b = bcp_NewBCLWithRandomTautology(p, 10, 1);
+  d = NULL;
+  p->subtract_stat.is_record = 1;
+  for( pos = BCP_SUBTRACT_ORDER_LIST; pos <= BCP_SUBTRACT_ORDER_GREEDY; pos++ )
+  {
+    p->subtract_order = pos;
+    c = bcp_NewBCLByBCL(p, a);
+    assert(bcp_SubtractBCL(p, c, b, 0) != 0);
+    assert(p->subtract_stat.step_cnt == b->cnt);
+    assert(p->subtract_stat.size_list[b->cnt-1] == c->cnt);
+    assert(p->subtract_stat.peak_cnt >= c->cnt);
+    if ( d == NULL )
+      d = c;
+    else
+    {
+      assert(bcp_IsBCLEqual(p, c, d) != 0);
+      bcp_DeleteBCL(p, c);
+    }
+  }
+  assert(bcp_GetSubtractOrderByName("greedy") == BCP_SUBTRACT_ORDER_GREEDY);
+  assert(bcp_GetSubtractOrderByName("none") < 0);
+  bcp_DeleteBCL(p, d);
+  bcp_DeleteBCL(p, b);
+  bcp_DeleteBCL(p, a);
+  bcp_Delete(p);
+
+  printf("Generated spill tests\n");
+  p = bcp_New(16);
+  assert(p != NULL);
+  for( pos = 0; pos < 4; pos++ )
+  {
+    a = bcp_NewBCLWithRandomTautology(p, 40, 4);
+    b = bcp_NewBCLWithRandomTautology(p, 20, 2);
+    p->spill_cnt = 0;
+    d = bcp_NewBCLByBCL(p, a);
+    assert(bcp_SubtractBCL(p, d, b, 1) != 0);
+    p->spill_cnt = 24;
+    c = bcp_NewBCLByBCL(p, a);
+    assert(bcp_IsBCLSpilled(p, c) != 0);
+    assert(bcp_SubtractBCL(p, c, b, 1) != 0);
+    assert(bcp_IsBCLEqual(p, c, d) != 0);
+    bcp_DeleteBCL(p, c);
+    bcp_DeleteBCL(p, d);
+    
+    p->spill_cnt = 0;
+    d = bcp_NewBCLByBCL(p, a);
+    assert(bcp_IntersectionBCL(p, d, b) != 0);
+    p->spill_cnt = 24;
+    c = bcp_NewBCLByBCL(p, a);
+    assert(bcp_IntersectionBCL(p, c, b) != 0);
+    assert(bcp_IsBCLEqual(p, c, d) != 0);
+    bcp_DeleteBCL(p, c);
+    bcp_DeleteBCL(p, d);
+    bcp_DeleteBCL(p, b);
+    bcp_DeleteBCL(p, a);
+  }
+  assert(p->spill_list_cnt > 0);
+  a = bcp_NewBCLWithRandomTautology(p, 40, 4);
+  p->spill_cnt = 24;
+  p->spill_dir = "/nonexistent/bcspill";        // the temporary file can not be created
+  assert(a->cnt >= p->spill_cnt);
+  assert(bcp_NewBCLByBCL(p, a) == NULL);
+  assert(p->spill_cnt == 24);                   // spilling is not disabled
+  p->spill_dir = NULL;
+  c = bcp_NewBCLByBCL(p, a);
+  assert(c != NULL && bcp_IsBCLSpilled(p, c) != 0);
+  bcp_DeleteBCL(p, c);
+  bcp_DeleteBCL(p, a);
+  p->spill_cnt = 0;
+  bcp_Delete(p);
+
+  printf("Generated intersection join tests\n");
+  p = bcp_New(16);
+  assert(p != NULL);
+  for( pos = 0; pos < 4; pos++ )
+  {
+    a = bcp_NewBCLWithRandomTautology(p, 300, 4);
+    b = bcp_NewBCLWithRandomTautology(p, 200, 4);
+    for( i = 0; i < a->cnt; i++ )       // selective variables: fix the first variables of "a"
+      for( j = 0; j < pos; j++ )
+        bcp_SetCubeVar(p, bcp_GetBCLCube(p, a, i), j, 2);
+    bcp_DoBCLSingleCubeContainment(p, a);
+    c = bcp_NewBCL(p);
+    assert(bcp_IntersectionBCLs(p, c, a, b) != 0);      // bucket join
+    d = bcp_NewBCL(p);
+    off = bcp_NewBCL(p);
+    grp_list = bcp_NewBCL(p);
+    for( i = 0; i < b->cnt; i++ )       // nested loop: less than BCP_INTERSECTION_JOIN_MIN_CNT pairs for each cube of "b"
+    {
+      bcp_ClearBCL(p, grp_list);
+      assert(bcp_AddBCLCubeByCube(p, grp_list, bcp_GetBCLCube(p, b, i)) >= 0);
+      assert(bcp_IntersectionBCLs(p, off, a, grp_list) != 0);
+      assert(bcp_AddBCLCubesByBCL(p, d, off) != 0);
+    }
+    bcp_DoBCLSingleCubeContainment(p, d);
+    assert(c->cnt == d->cnt);
+    assert(bcp_IsBCLEqual(p, c, d) != 0);
+    bcp_DeleteBCL(p, grp_list);
+    bcp_DeleteBCL(p, off);
+    bcp_DeleteBCL(p, d);
+    bcp_DeleteBCL(p, c);
+    bcp_DeleteBCL(p, b);
+    bcp_DeleteBCL(p, a);
+  }
+  bcp_Delete(p);
+
+  printf("Generated intersection empty tests\n");
+  p = bcp_New(10);
+  assert(p != NULL);
+  hit_cnt = 0;
+  for( pos = 0; pos < 90; pos++ )
+  {
+    /* pos%3: 0 no xgroup, 1 disjoint xgroups {0,1,2} {3,4,5}, 2 overlapping xgroups {0,1,2} {2,3,4} */
+    bcp_ClearBCL(p, p->exclude_group_list);
+    for( i = 0; i < (pos%3 == 0 ? 0 : 2); i++ )
+    {
+      j = bcp_AddBCLCubeByCube(p, p->exclude_group_list, bcp_GetGlobalCube(p, 3));
+      assert(j >= 0);
+      cube = bcp_GetBCLCube(p, p->exclude_group_list, j);
+      bcp_SetCubeVar(p, cube, i*(pos%3 == 1 ? 3 : 2), 2);
+      bcp_SetCubeVar(p, cube, i*(pos%3 == 1 ? 3 : 2)+1, 2);
+      bcp_SetCubeVar(p, cube, i*(pos%3 == 1 ? 3 : 2)+2, 2);
+    }
+    c = bcp_NewBCLWithRandomTautology(p, 40, 6);
+    d = bcp_NewBCLWithRandomTautology(p, 40, 6);
+    a = bcp_NewBCL(p);
+    b = bcp_NewBCL(p);
+    for( i = 0; i < 1 + pos%4; i++ )
+    {
+      assert(bcp_AddBCLCubeByCube(p, a, bcp_GetBCLCube(p, c, i)) >= 0);
+      assert(bcp_AddBCLCubeByCube(p, b, bcp_GetBCLCube(p, d, i)) >= 0);
+    }
+    assert(bcp_CopyBCL(p, c, a) != 0);
+    assert(bcp_IntersectionBCL(p, c, b) != 0);
+    assert(bcp_DoBCLXGroup(p, c) != 0);
+    tautology = bcp_IsBCLIntersectionEmpty(p, a, b);
+    assert(tautology == (c->cnt == 0));
+    hit_cnt += tautology;
+    bcp_DeleteBCL(p, d);
+    bcp_DeleteBCL(p, c);
+    bcp_DeleteBCL(p, b);
+    bcp_DeleteBCL(p, a);
+  }
+  assert(hit_cnt > 0 && hit_cnt < pos);         // both cases have been tested
+  bcp_Delete(p);
+
+  printf("Generated blocking matrix expand tests\n");
+  for( pos = 0; pos < 8; pos++ )
+  {
+    p = bcp_New(pos < 4 ? 14 : 90);     // more than one block
+    assert(p != NULL);
+    c = bcp_NewBCLWithRandomTautology(p, 80, 4);
+    a = bcp_NewBCL(p);
+    for( i = 0; i < 30; i++ )
+      assert(bcp_AddBCLCubeByCube(p, a, bcp_GetBCLCube(p, c, (i*7) % c->cnt)) >= 0);
+    off = bcp_NewBCLComplement(p, a);
+    assert(off != NULL);
+    b = bcp_NewBCLByBCL(p, a);
+    bcp_DoBCLExpandWithOffSet(p, b, off);
+    assert(b->cnt <= a->cnt);
+    assert(bcp_IsBCLEqual(p, a, b) != 0);
+    for( i = 0; i < b->cnt; i++ )       // each cube must be a prime
+    {
+      cube = bcp_GetBCLCube(p, b, i);
+      for( j = 0; j < p->var_cnt; j++ )
+      {
+        tautology = bcp_GetCubeVar(p, cube, j);
+        if ( tautology == 3 )
+          continue;
+        bcp_SetCubeVar(p, cube, j, 3);
+        assert(bcp_IsBCLCubeCovered(p, a, cube) == 0);
+        bcp_SetCubeVar(p, cube, j, tautology);
+      }
+    }
+    bcp_DeleteBCL(p, b);
+    bcp_DeleteBCL(p, off);
+    bcp_DeleteBCL(p, a);
+    bcp_DeleteBCL(p, c);
+    bcp_Delete(p);
+  }
+
+  printf("Generated simple expand tests\n");
+  p = bcp_New(16);
+  assert(p != NULL);
+  a = bcp_NewBCLByString(p, "0-10000000000000\n1-10000000000000\n--11000000000000\n");
+  bcp_DoBCLSimpleExpand(p, a);          // merge with variable 0 ("--10...") and then with variable 3
+  generated_expect_equal_cubes(p, "bcp_DoBCLSimpleExpand", a, "--1-000000000000\n");
+  bcp_DeleteBCL(p, a);
+  for( pos = 0; pos < 6; pos++ )
+  {
+    c = bcp_NewBCLWithRandomTautology(p, 300, 2);
+    a = bcp_NewBCL(p);
+    for( i = 0; i < 200; i++ )
+      assert(bcp_AddBCLCubeByCube(p, a, bcp_GetBCLCube(p, c, (i*7) % c->cnt)) >= 0);
+    b = bcp_NewBCLByBCL(p, a);
+    bcp_DoBCLSimpleExpand(p, b);
+    assert(b->cnt <= a->cnt);
+    assert(bcp_IsBCLEqual(p, a, b) != 0);
+    bcp_DeleteBCL(p, b);
+    bcp_DeleteBCL(p, a);
+    bcp_DeleteBCL(p, c);
+  }
+  bcp_Delete(p);
+
+  printf("Generated espresso tests\n");
+  for( pos = 0; pos < 8; pos++ )
+  {
+    p = bcp_New(pos < 4 ? 12 : 70);     // more than one block
+    assert(p != NULL);
+    c = bcp_NewBCLWithRandomTautology(p, 60, 4);
+    a = bcp_NewBCL(p);
+    for( i = 0; i < 40; i++ )
+      assert(bcp_AddBCLCubeByCube(p, a, bcp_GetBCLCube(p, c, (i*5) % c->cnt)) >= 0);
+    b = bcp_NewBCLByBCL(p, a);
+    d = bcp_NewBCLByBCL(p, a);
+    bcp_MinimizeBCL(p, d);              // default mode
+    p->minimize_mode = BCP_MINIMIZE_MODE_ESPRESSO;
+    bcp_MinimizeBCL(p, b);
+    p->minimize_mode = BCP_MINIMIZE_MODE_DEFAULT;
+    assert(p->espresso_stat.iteration_cnt > 0);
+    assert(bcp_IsBCLEqual(p, a, b) != 0);
+    assert(b->cnt <= d->cnt);
+    assert(b->cnt < p->espresso_stat.cube_cnt_list[0]
+      || (b->cnt == p->espresso_stat.cube_cnt_list[0] && bcp_GetBCLLiteralCnt(p, b) <= p->espresso_stat.literal_cnt_list[0]));
+    bcp_DoBCLReduce(p, b);              // reduce must not change the function
+    assert(bcp_IsBCLEqual(p, a, b) != 0);
+    assert(bcp_CopyBCL(p, d, a) != 0);
+    p->minimize_mode = BCP_MINIMIZE_MODE_ESPRESSO;
+    bcp_MinimizeBCL(p, d);              // same input again: result from the result cache
+    p->minimize_mode = BCP_MINIMIZE_MODE_DEFAULT;
+    assert(p->espresso_stat.iteration_cnt == -1);      // no statistics for a cached result
+    assert(bcp_IsBCLEqual(p, a, d) != 0);
+    bcp_DeleteBCL(p, d);
+    bcp_DeleteBCL(p, b);
+    bcp_DeleteBCL(p, a);
+    bcp_DeleteBCL(p, c);
+    bcp_Delete(p);
+  }
+
+  printf("Generated exact minimize tests\n");
+  p = bcp_New(3);
+  assert(p != NULL);
+  a = bcp_NewBCLByString(p, "000\n001\n010\n101\n110\n111\n");     // cyclic function: six primes, three are required
+  b = bcp_NewBCLPrimes(p, a);
+  assert(b != NULL);
+  generated_expect_equal_cubes(p, "bcp_NewBCLPrimes", b, "00-\n0-0\n-01\n-10\n1-1\n11-\n");
+  assert(bcp_MinimizeBCLExact(p, b) == 1);
+  assert(b->cnt == 3);
+  assert(bcp_IsBCLEqual(p, a, b) != 0);
+  bcp_DeleteBCL(p, b);
+  bcp_DeleteBCL(p, a);
+  bcp_Delete(p);
+  for( pos = 0; pos < 12; pos++ )
+  {
+    int v;
+    p = bcp_New(pos < 6 ? 7 : 70);      // more than one block, only a few variables are used
+    assert(p != NULL);
+    a = bcp_NewBCL(p);
+    for( i = 0; i < 24; i++ )
+    {
+      j = bcp_AddBCLCubeByCube(p, a, bcp_GetGlobalCube(p, 3));
+      assert(j >= 0);
+      cube = bcp_GetBCLCube(p, a, j);
+      for( j = 0; j < 7; j++ )
+        bcp_SetCubeVar(p, cube, (j*11) % p->var_cnt, (i*7+j*j+pos) % 5 == 0 ? 3 : 1 + ((i*13+j*5+pos) / 3) % 2);
+    }
+    b = bcp_NewBCLByBCL(p, a);
+    d = bcp_NewBCLByBCL(p, a);
+    p->minimize_mode = BCP_MINIMIZE_MODE_ESPRESSO;
+    bcp_MinimizeBCL(p, d);
+    p->minimize_mode = BCP_MINIMIZE_MODE_EXACT;
+    bcp_MinimizeBCL(p, b);
+    p->minimize_mode = BCP_MINIMIZE_MODE_DEFAULT;
+    assert(p->is_minimize_exact == 1);
+    assert(bcp_IsBCLEqual(p, a, b) != 0);
+    assert(b->cnt <= d->cnt);
+    for( i = 0; i < b->cnt; i++ )       // each cube must be a prime
+    {
+      cube = bcp_GetBCLCube(p, b, i);
+      for( j = 0; j < p->var_cnt; j++ )
+      {
+        v = bcp_GetCubeVar(p, cube, j);
+        if ( v == 3 )
+          continue;
+        bcp_SetCubeVar(p, cube, j, 3);
+        assert(bcp_IsBCLCubeCovered(p, a, cube) == 0);
+        bcp_SetCubeVar(p, cube, j, v);
+      }
+    }
+    /* budget exceeded: "a" is binate, so the prime calculation needs more than one node */
+    assert(bcp_GetBCLMaxBinateSplitVariable(p, a) >= 0);
+    bcp_CopyBCL(p, b, a);
+    bcp_SetGovernor(p, 0.0, 1, 0);
+    assert(bcp_MinimizeBCLExact(p, b) == 0);
+    bcp_SetGovernor(p, 0.0, 0, 0);
+    assert(bcp_IsBCLEqual(p, a, b) != 0);
+    for( i = 0; i < b->cnt; i++ )       // the heuristic result is irredundant
+      assert(bcp_IsBCLCubeRedundant(p, b, i) == 0);
+    bcp_DeleteBCL(p, d);
+    bcp_DeleteBCL(p, b);
+    bcp_DeleteBCL(p, a);
+    bcp_Delete(p);
+  }
+}
@@ -324,6 +324,21 @@ int bcp_GetCubeVariableCount(bcp p, bc cube)
   return delta;
 }
 
+/*
+  64 bit signature of the literals of "c": the inverted codes of all blocks are folded with OR.
+  If "b" is a subset of "a", then the signature of "a" is a subset of the signature of "b",
+  so (sig(a) & ~sig(b)) != 0 proves that "b" is not a subset of "a".
+*/
+uint64_t bcp_GetCubeLiteralSignature(bcp p, bc c)
+{
+  int i, cnt = p->blk_cnt;
+  __m128i v = _mm_setzero_si128();
+  for( i = 0; i < cnt; i++ )
+    v = _mm_or_si128(v, _mm_andnot_si128(_mm_loadu_si128(c+i), _mm_set1_epi8(-1)));
+  v = _mm_or_si128(v, _mm_unpackhi_epi64(v, v));
+  return (uint64_t)_mm_cvtsi128_si64(v);
+}
+
 int bcp_GetCubeDelta(bcp p, bc a, bc b)
 {
   int i, cnt = p->blk_cnt;
@@ -365,3 +380,26 @@ int bcp_IsSubsetCube(bcp p, bc a, bc b)
   return 1;
 }
 
+
+/*
+  calculate a 64 bit hash value for cube "c"
+  equal cubes will have the same hash value
+  used as a building block for fingerprints of cube lists
+*/
+uint64_t bcp_GetCubeHash(bcp p, bc c)
+{
+  int i, cnt = p->blk_cnt;
+  uint64_t h = 0x9e3779b97f4a7c15ULL;
+  __m128i v;
+  for( i = 0; i < cnt; i++ )
+  {
+    v = _mm_loadu_si128(c+i);
+    h ^= (uint64_t)_mm_cvtsi128_si64(v);
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 32;
+    h ^= (uint64_t)_mm_cvtsi128_si64(_mm_unpackhi_epi64(v, v));
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 29;
+  }
+  return h;
+}